@@ -1,6 +1,24 @@
 #include <pebble.h>
 #include "common.h"
 
+typedef struct {
+  GBitmap *bitmap;
+  uint32_t resourceId;
+  uint16_t refCount;
+  uint16_t lastUsed;
+} BitmapCacheEntry;
+
+static uint8_t _layerArena[LAYER_ARENA_SIZE] __attribute__((aligned(4)));
+static size_t _layerArenaUsed = 0;
+
+static BitmapCacheEntry _bitmapCache[BITMAP_CACHE_SIZE];
+static uint16_t _bitmapCacheClock = 0;
+
+static BitmapCacheEntry* findCacheEntry(uint32_t resourceId);
+static BitmapCacheEntry* findLeastRecentlyUsed();
+static uint16_t countWarmEntries();
+static void evictCacheEntry(BitmapCacheEntry* entry);
+
 void AddLayer(Layer* relativeLayer, Layer* newLayer, LayerRelation relation) {
   switch (relation) {
     case ABOVE_SIBLING:
@@ -17,13 +35,51 @@ void AddLayer(Layer* relativeLayer, Layer* newLayer, LayerRelation relation) {
   }
 }
 
+// Bump allocate zeroed memory from the layer arena. Returns NULL when the
+// arena is exhausted. Nothing is freed until ArenaReset.
+void* ArenaAlloc(size_t size) {
+  size = ARENA_ALIGN(size);
+  if (_layerArenaUsed + size > LAYER_ARENA_SIZE) {
+    MY_APP_LOG(APP_LOG_LEVEL_ERROR, "Layer arena exhausted, %i bytes requested", (int) size);
+    return NULL;
+  }
+  
+  void* memory = &_layerArena[_layerArenaUsed];
+  _layerArenaUsed += size;
+  memset(memory, 0, size);
+  return memory;
+}
+
+void ArenaReset() {
+  _layerArenaUsed = 0;
+}
+
+void SetBitmapGroupResource(BitmapGroup* group, uint32_t resourceId) {
+  if (group->resourceId == resourceId) {
+    return;
+  }
+  
+  if (group->resourceId != 0) {
+    ReleaseBitmap(group->resourceId);
+    group->bitmap = NULL;
+    group->resourceId = 0;
+  }
+  
+  group->bitmap = AcquireBitmap(resourceId);
+  if (group->bitmap != NULL) {
+    group->resourceId = resourceId;
+  }
+  
+  bitmap_layer_set_bitmap(group->layer, group->bitmap);
+}
+
 void DestroyBitmapGroup(BitmapGroup* group) {
   if (group != NULL) {
-    if (group->bitmap != NULL) {
-      gbitmap_destroy(group->bitmap);
-      group->bitmap = NULL;
+    if (group->resourceId != 0) {
+      ReleaseBitmap(group->resourceId);
     }
     
+    group->bitmap = NULL;
     group->resourceId = 0;
     
     if (group->layer != NULL) {
@@ -33,3 +89,109 @@ void DestroyBitmapGroup(BitmapGroup* group) {
     }
   }
 }
+
+
+// Return a shared bitmap for the resource, decoding it only if not cached.
+// Every successful call must be paired with ReleaseBitmap.
+GBitmap* AcquireBitmap(uint32_t resourceId) {
+  BitmapCacheEntry* entry = findCacheEntry(resourceId);
+  
+  if (entry == NULL) {
+    entry = findCacheEntry(0);
+    if (entry == NULL) {
+      entry = findLeastRecentlyUsed();
+      if (entry == NULL) {
+        MY_APP_LOG(APP_LOG_LEVEL_ERROR, "Bitmap cache full, resource %i", (int) resourceId);
+        return NULL;
+      }
+      
+      evictCacheEntry(entry);
+    }
+    
+    entry->bitmap = gbitmap_create_with_resource(resourceId);
+    if (entry->bitmap == NULL) {
+      return NULL;
+    }
+    
+    entry->resourceId = resourceId;
+  }
+  
+  entry->refCount++;
+  entry->lastUsed = ++_bitmapCacheClock;
+  return entry->bitmap;
+}
+
+// Unreferenced bitmaps stay warm until more than BITMAP_CACHE_WARM are idle.
+void ReleaseBitmap(uint32_t resourceId) {
+  BitmapCacheEntry* entry = findCacheEntry(resourceId);
+  if (entry == NULL || entry->refCount == 0) {
+    return;
+  }
+  
+  entry->refCount--;
+  
+  if (entry->refCount == 0 && countWarmEntries() > BITMAP_CACHE_WARM) {
+    evictCacheEntry(findLeastRecentlyUsed());
+  }
+}
+
+bool BitmapCacheContains(uint32_t resourceId) {
+  return (findCacheEntry(resourceId) != NULL);
+}
+
+void DestroyBitmapCache() {
+  for (int index = 0; index < BITMAP_CACHE_SIZE; index++) {
+    evictCacheEntry(&_bitmapCache[index]);
+  }
+}
+
+static BitmapCacheEntry* findCacheEntry(uint32_t resourceId) {
+  for (int index = 0; index < BITMAP_CACHE_SIZE; index++) {
+    if (_bitmapCache[index].resourceId == resourceId) {
+      return &_bitmapCache[index];
+    }
+  }
+  
+  return NULL;
+}
+
+// Find the least recently used entry that no one holds a reference to.
+static BitmapCacheEntry* findLeastRecentlyUsed() {
+  BitmapCacheEntry* oldest = NULL;
+  
+  for (int index = 0; index < BITMAP_CACHE_SIZE; index++) {
+    BitmapCacheEntry* entry = &_bitmapCache[index];
+    if (entry->resourceId != 0 && entry->refCount == 0 &&
+        (oldest == NULL || (uint16_t) (_bitmapCacheClock - entry->lastUsed) > (uint16_t) (_bitmapCacheClock - oldest->lastUsed))) {
+      oldest = entry;
+    }
+  }
+  
+  return oldest;
+}
+
+static uint16_t countWarmEntries() {
+  uint16_t count = 0;
+  
+  for (int index = 0; index < BITMAP_CACHE_SIZE; index++) {
+    if (_bitmapCache[index].resourceId != 0 && _bitmapCache[index].refCount == 0) {
+      count++;
+    }
+  }
+  
+  return count;
+}
+
+static void evictCacheEntry(BitmapCacheEntry* entry) {
+  if (entry == NULL) {
+    return;
+  }
+  
+  if (entry->bitmap != NULL) {
+    gbitmap_destroy(entry->bitmap);
+    entry->bitmap = NULL;
+  }
+  
+  entry->resourceId = 0;
+  entry->refCount = 0;
+}
\ No newline at end of file
@@ -1,17 +1,33 @@
 #pragma once
   
-//#define RUN_TEST true 
-//#define LOGGING_ON true
+// RUN_TEST, LOGGING_ON, TRACE_ON, SMOOTH_FILL and VECTOR_DIGITS are set by the build variants and options in wscript.
+
+#include "log_buffer.h"
 
 #define INSTALLED_VERSION 13
 
 #define SCREEN_WIDTH 144
 #define SCREEN_HEIGHT 168
 #define WATER_RISE_DURATION 500
+
+// Heap bytes the hour layer may spend decoding the next hour's digits early.
+#define HOUR_PREFETCH_BUDGET 1400
+
+// Bitmap cache slots, and how many unreferenced bitmaps are kept warm (LRU).
+#define BITMAP_CACHE_SIZE 8
+#define BITMAP_CACHE_WARM 2
+
+// Static storage for all *LayerData structs, checked against their sizes in main.c.
+// Host builds (tools/host) have 8-byte pointers and pass a larger size.
+#ifndef LAYER_ARENA_SIZE
+#define LAYER_ARENA_SIZE 160
+#endif
+#define ARENA_ALIGN(size) (((size) + 3) & ~3)
   
 #ifdef LOGGING_ON
+  // Records are buffered and written out later so logging does not skew timing.
   #define MY_APP_LOG(level, fmt, args...)                                \
-    app_log(level, __FILE_NAME__, __LINE__, fmt, ## args)
+    LogBufferWrite(level, __FILE_NAME__, __LINE__, fmt, LOG_ARG_COUNT(args), ## args)
 #else
   #define MY_APP_LOG(level, fmt, args...)
 #endif
@@ -28,4 +44,11 @@ typedef struct {
 } BitmapGroup;
 
 void AddLayer(Layer *relativeLayer, Layer *newLayer, LayerRelation relation);
-void DestroyBitmapGroup(BitmapGroup* group);
\ No newline at end of file
+void* ArenaAlloc(size_t size);
+void ArenaReset();
+void SetBitmapGroupResource(BitmapGroup* group, uint32_t resourceId);
+void DestroyBitmapGroup(BitmapGroup* group);
+GBitmap* AcquireBitmap(uint32_t resourceId);
+void ReleaseBitmap(uint32_t resourceId);
+bool BitmapCacheContains(uint32_t resourceId);
+void DestroyBitmapCache();
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include <pebble.h>
 #include "hour_layer.h"
+#ifdef VECTOR_DIGITS
+#include "vector_digits.h"
+#endif
   
 #define NUMBER_TOP 41
 #define LEFT_HOUR_LEFT 12
@@ -8,6 +11,15 @@
 #define NUMBER_HEIGHT 84
 #define NUMBER_WIDTH 59
 
+typedef enum { LEFT_DIGIT, MIDDLE_DIGIT, RIGHT_DIGIT } DigitPosition;
+
+#ifndef VECTOR_DIGITS
+// Start prefetching once the minute 59 water animation has finished.
+#define PREFETCH_DELAY (WATER_RISE_DURATION * 2)
+
+// Heap cost of one decoded 1-bit digit bitmap (rows are padded to 32 bits).
+#define DIGIT_BITMAP_BYTES (((NUMBER_WIDTH + 31) / 32) * 4 * NUMBER_HEIGHT)
+
 static uint32_t _hourResource[10] = { 
   RESOURCE_ID_IMAGE_0, RESOURCE_ID_IMAGE_1, RESOURCE_ID_IMAGE_2, 
   RESOURCE_ID_IMAGE_3, RESOURCE_ID_IMAGE_4, RESOURCE_ID_IMAGE_5, 
@@ -16,12 +28,73 @@ static uint32_t _hourResource[10] = {
 };
 
 static void drawHourGroup(BitmapGroup* group, uint16_t digit);
+static void prefetchTimerCallback(void *callback_data);
+static void releasePrefetch(HourLayerData* data);
+#else
+static void hourLayerUpdateProc(Layer *layer, GContext *ctx);
+#endif
+
+static void getDigits(uint16_t hour, int16_t digits[3]);
 static uint16_t getHour(uint16_t hour);
 
+#ifdef VECTOR_DIGITS
+HourLayerData* CreateHourLayer(Layer* relativeLayer, LayerRelation relation) {
+  HourLayerData* data = ArenaAlloc(sizeof(HourLayerData));
+  if (data != NULL) {
+    data->layer = layer_create_with_data(GRect(LEFT_HOUR_LEFT, NUMBER_TOP, RIGHT_HOUR_LEFT + NUMBER_WIDTH - LEFT_HOUR_LEFT, NUMBER_HEIGHT),
+                                         sizeof(int16_t) * 3);
+    int16_t* shown = layer_get_data(data->layer);
+    shown[LEFT_DIGIT] = shown[MIDDLE_DIGIT] = shown[RIGHT_DIGIT] = -1;
+    layer_set_update_proc(data->layer, hourLayerUpdateProc);
+    AddLayer(relativeLayer, data->layer, relation);
+  }
+  
+  return data;
+}
+
+void DestroyHourLayer(HourLayerData* data) {
+  if (data != NULL) {
+    if (data->layer != NULL) {
+      layer_destroy(data->layer);
+      data->layer = NULL;
+    }
+  }
+}
+
+void DrawHourLayer(HourLayerData* data, uint16_t hour, uint16_t minute) {
+  int16_t* shown = layer_get_data(data->layer);
+  int16_t digits[3];
+  getDigits(hour, digits);
+  
+  // Only the top of the hour (or a 12/24h change) needs a redraw.
+  bool changed = false;
+  for (int position = LEFT_DIGIT; position <= RIGHT_DIGIT; position++) {
+    if (shown[position] != digits[position]) {
+      shown[position] = digits[position];
+      changed = true;
+    }
+  }
+  
+  if (changed == true) {
+    layer_mark_dirty(data->layer);
+  }
+}
+
+static void hourLayerUpdateProc(Layer *layer, GContext *ctx) {
+  static const int16_t left[3] = { 0, MIDDLE_HOUR_LEFT - LEFT_HOUR_LEFT, RIGHT_HOUR_LEFT - LEFT_HOUR_LEFT };
+  int16_t* digits = layer_get_data(layer);
+  
+  for (int position = LEFT_DIGIT; position <= RIGHT_DIGIT; position++) {
+    if (digits[position] != -1) {
+      DrawVectorDigit(ctx, digits[position], GRect(left[position], 0, NUMBER_WIDTH, NUMBER_HEIGHT));
+    }
+  }
+}
+#else
 HourLayerData* CreateHourLayer(Layer* relativeLayer, LayerRelation relation) {
-  HourLayerData* data = malloc(sizeof(HourLayerData));
+  HourLayerData* data = ArenaAlloc(sizeof(HourLayerData));
   if (data != NULL) {
-    memset(data, 0, sizeof(HourLayerData));
+    data->prefetchHour = -1;
     
     data->leftHour.layer = bitmap_layer_create(GRect(LEFT_HOUR_LEFT, NUMBER_TOP, NUMBER_WIDTH, NUMBER_HEIGHT));
     bitmap_layer_set_compositing_mode(data->leftHour.layer, GCompOpAnd);
@@ -41,70 +114,78 @@ HourLayerData* CreateHourLayer(Layer* relativeLayer, LayerRelation relation) {
 
 void DestroyHourLayer(HourLayerData* data) {
   if (data != NULL) {
+    releasePrefetch(data);
     DestroyBitmapGroup(&data->leftHour);
     DestroyBitmapGroup(&data->middleHour);
     DestroyBitmapGroup(&data->rightHour);
-    free(data);
   }
 }
 
 void DrawHourLayer(HourLayerData* data, uint16_t hour, uint16_t minute) {
-  int16_t leftDigit = -1;
-  int16_t middleDigit = -1;
-  int16_t rightDigit = -1;
-  uint16_t trueHour = getHour(hour);
+  int16_t digits[3];
+  getDigits(hour, digits);
   
-  if (clock_is_24h_style() == true) {
-    leftDigit = trueHour / 10;
-    rightDigit = trueHour % 10;
-    
-  } else {
-    if (trueHour < 10) {
-      middleDigit = trueHour;
-      
-    } else {
-      leftDigit = 1;
-      rightDigit = trueHour % 10;
-    }
-  }
-  
-  if (leftDigit == -1) {
+  if (digits[LEFT_DIGIT] == -1) {
     layer_set_hidden((Layer*) data->leftHour.layer, true);
     
   } else {
-    drawHourGroup(&data->leftHour, leftDigit);
+    drawHourGroup(&data->leftHour, digits[LEFT_DIGIT]);
   }
   
-  if (middleDigit == -1) {
+  if (digits[MIDDLE_DIGIT] == -1) {
     layer_set_hidden((Layer*) data->middleHour.layer, true);
     
   } else {
-    drawHourGroup(&data->middleHour, middleDigit);
+    drawHourGroup(&data->middleHour, digits[MIDDLE_DIGIT]);
   }
   
-  if (rightDigit == -1) {
+  if (digits[RIGHT_DIGIT] == -1) {
     layer_set_hidden((Layer*) data->rightHour.layer, true);
     
   } else {
-    drawHourGroup(&data->rightHour, rightDigit);
+    drawHourGroup(&data->rightHour, digits[RIGHT_DIGIT]);
+  }
+  
+  // The groups now hold their own references, so drop the prefetch ones
+  // unless they are still waiting for the next hour.
+  if (data->prefetchHour != -1 && data->prefetchHour != (hour + 1) % 24) {
+    releasePrefetch(data);
+  }
+  
+  // Decode the next hour's digits at a quiet moment rather than at the top of the hour.
+  if (minute == 59 && data->prefetchHour == -1) {
+    data->prefetchHour = (hour + 1) % 24;
+    data->prefetchTimer = app_timer_register(PREFETCH_DELAY, prefetchTimerCallback, data);
   }
 }
 
 static void drawHourGroup(BitmapGroup* group, uint16_t digit) {
-  if (group->resourceId != _hourResource[digit]) {
-    if (group->bitmap != NULL) {
-      gbitmap_destroy(group->bitmap);
-      group->bitmap = NULL;
-      group->resourceId = 0;
-    }
-    
-    group->bitmap = gbitmap_create_with_resource(_hourResource[digit]);
-    bitmap_layer_set_bitmap(group->layer, group->bitmap);
-    group->resourceId = _hourResource[digit];
-  }  
-  
+  // Shared through the bitmap cache, so a prefetched digit is already decoded.
+  SetBitmapGroupResource(group, _hourResource[digit]);
   layer_set_hidden(bitmap_layer_get_layer(group->layer), false);
 }
+#endif
+
+static void getDigits(uint16_t hour, int16_t digits[3]) {
+  uint16_t trueHour = getHour(hour);
+  digits[LEFT_DIGIT] = -1;
+  digits[MIDDLE_DIGIT] = -1;
+  digits[RIGHT_DIGIT] = -1;
+  
+  if (clock_is_24h_style() == true) {
+    digits[LEFT_DIGIT] = trueHour / 10;
+    digits[RIGHT_DIGIT] = trueHour % 10;
+    
+  } else {
+    if (trueHour < 10) {
+      digits[MIDDLE_DIGIT] = trueHour;
+      
+    } else {
+      digits[LEFT_DIGIT] = 1;
+      digits[RIGHT_DIGIT] = trueHour % 10;
+    }
+  }
+}
 
 static uint16_t getHour(uint16_t hour) {
   if (clock_is_24h_style() == true) {
@@ -113,4 +194,56 @@ static uint16_t getHour(uint16_t hour) {
   
   int hour12 = hour % 12;
   return (hour12 == 0) ? 12 : hour12;
-}
\ No newline at end of file
+}
+
+#ifndef VECTOR_DIGITS
+static void prefetchTimerCallback(void *callback_data) {
+  HourLayerData* data = (HourLayerData*) callback_data;
+  data->prefetchTimer = NULL;
+  
+  int16_t digits[3];
+  getDigits(data->prefetchHour, digits);
+  
+  BitmapGroup* groups[3] = { &data->leftHour, &data->middleHour, &data->rightHour };
+  uint16_t budgetUsed = 0;
+  
+  for (int position = LEFT_DIGIT; position <= RIGHT_DIGIT; position++) {
+    if (digits[position] == -1 || groups[position]->resourceId == _hourResource[digits[position]]) {
+      // Nothing to swap in at this position.
+      continue;
+    }
+    
+    uint32_t resourceId = _hourResource[digits[position]];
+    bool cached = BitmapCacheContains(resourceId);
+    
+    if (cached == false &&
+        (budgetUsed + DIGIT_BITMAP_BYTES > HOUR_PREFETCH_BUDGET || heap_bytes_free() < DIGIT_BITMAP_BYTES)) {
+      // This digit will be loaded at the top of the hour as before.
+      continue;
+    }
+    
+    if (AcquireBitmap(resourceId) != NULL) {
+      data->prefetch[position] = resourceId;
+      budgetUsed += cached ? 0 : DIGIT_BITMAP_BYTES;
+    }
+  }
+  
+  MY_APP_LOG(APP_LOG_LEVEL_INFO, "Prefetched hour %i digits, %i bytes", (int) data->prefetchHour, (int) budgetUsed);
+}
+
+static void releasePrefetch(HourLayerData* data) {
+  if (data->prefetchTimer != NULL) {
+    app_timer_cancel(data->prefetchTimer);
+    data->prefetchTimer = NULL;
+  }
+  
+  for (int position = LEFT_DIGIT; position <= RIGHT_DIGIT; position++) {
+    if (data->prefetch[position] != 0) {
+      ReleaseBitmap(data->prefetch[position]);
+      data->prefetch[position] = 0;
+    }
+  }
+  
+  data->prefetchHour = -1;
+}
+#endif
\ No newline at end of file
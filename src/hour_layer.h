@@ -2,9 +2,19 @@
 #include "common.h"
 
 typedef struct {
+#ifdef VECTOR_DIGITS
+  // Draws all three digit positions; the layer data holds the digits shown.
+  Layer* layer;
+#else
   BitmapGroup leftHour;
   BitmapGroup middleHour;
   BitmapGroup rightHour;
+  
+  // Cache references held on the next hour's digits, indexed left/middle/right.
+  uint32_t prefetch[3];
+  int16_t prefetchHour;
+  AppTimer *prefetchTimer;
+#endif
 } HourLayerData;
 
 HourLayerData* CreateHourLayer(Layer* relativeLayer, LayerRelation relation);
@@ -0,0 +1,208 @@
+#include <pebble.h>
+#include "log_buffer.h"
+
+#ifdef LOGGING_ON
+
+#define LOG_BUFFER_SIZE 32
+#define LOG_FLUSH_DELAY 2000
+#define LOG_SEND_RETRIES 3
+
+// Compact record. The file and format strings are literals, so only their
+// addresses are stored and nothing is formatted until the record is flushed.
+typedef struct {
+  const char *file;
+  const char *fmt;
+  uint16_t line;
+  uint8_t level;
+  uint8_t argCount;
+  int32_t args[LOG_BUFFER_MAX_ARGS];
+} LogRecord;
+
+static LogRecord _records[LOG_BUFFER_SIZE];
+static uint16_t _head = 0;
+static uint16_t _count = 0;
+static uint16_t _dropped = 0;
+static AppTimer *_flushTimer = NULL;
+
+// Set once the phone asks for the log. From then on records are kept for the
+// phone and the idle flush to app_log is no longer armed.
+static bool _keepForPhone = false;
+
+// The phone asked for the log and has not yet been sent everything buffered.
+static bool _phoneWaiting = false;
+
+// The oldest record has been handed to the outbox and is waiting for its ack.
+static bool _sending = false;
+static uint8_t _sendRetries = 0;
+
+static void flushTimerCallback(void *callback_data);
+static LogRecord* peekRecord();
+static void popRecord();
+
+void LogBufferWrite(uint8_t level, const char *file, uint16_t line, const char *fmt, uint8_t argCount, ...) {
+  // Overwrite the oldest record when full.
+  if (_count == LOG_BUFFER_SIZE) {
+    popRecord();
+    _dropped++;
+  }
+  
+  LogRecord *record = &_records[(_head + _count) % LOG_BUFFER_SIZE];
+  record->file = file;
+  record->fmt = fmt;
+  record->line = line;
+  record->level = level;
+  record->argCount = argCount;
+  
+  va_list args;
+  va_start(args, argCount);
+  for (uint8_t index = 0; index < LOG_BUFFER_MAX_ARGS; index++) {
+    record->args[index] = (index < argCount) ? va_arg(args, int) : 0;
+  }
+  va_end(args);
+  
+  _count++;
+  
+  if (_flushTimer == NULL && _keepForPhone == false) {
+    _flushTimer = app_timer_register(LOG_FLUSH_DELAY, flushTimerCallback, NULL);
+  }
+}
+
+void LogBufferFlush() {
+  if (_dropped > 0) {
+    app_log(APP_LOG_LEVEL_WARNING, __FILE_NAME__, __LINE__, "%i log records dropped", (int) _dropped);
+    _dropped = 0;
+  }
+  
+  LogRecord *record;
+  while ((record = peekRecord()) != NULL) {
+    app_log(record->level, record->file, record->line, record->fmt,
+            (int) record->args[0], (int) record->args[1], (int) record->args[2]);
+    popRecord();
+  }
+}
+
+// Start sending the buffered records to the phone. If the outbox is busy,
+// sending starts from the next LogBufferSendNext.
+void LogBufferStartSend() {
+  _keepForPhone = true;
+  if (_flushTimer != NULL) {
+    app_timer_cancel(_flushTimer);
+    _flushTimer = NULL;
+  }
+  
+  _phoneWaiting = true;
+  LogBufferSendNext();
+}
+
+// Send the oldest record to the phone. Returns false when the phone is not
+// waiting for records, the buffer is empty, a record is already in flight or
+// the outbox is busy. The record stays buffered until LogBufferSent, which
+// continues with the next one.
+bool LogBufferSendNext() {
+  if (_phoneWaiting == false || _sending) {
+    return false;
+  }
+  
+  LogRecord *record = peekRecord();
+  if (record == NULL) {
+    _phoneWaiting = false;
+    return false;
+  }
+  
+  DictionaryIterator *iter;
+  app_message_outbox_begin(&iter);
+
+  if (iter == NULL) {
+    return false;
+  }
+  
+  static const uint32_t argKeys[LOG_BUFFER_MAX_ARGS] = { KEY_LOG_ARG0, KEY_LOG_ARG1, KEY_LOG_ARG2 };
+  
+  dict_write_cstring(iter, KEY_LOG_FILE, record->file);
+  dict_write_int32(iter, KEY_LOG_LINE, record->line);
+  dict_write_cstring(iter, KEY_LOG_FORMAT, record->fmt);
+  for (uint8_t index = 0; index < record->argCount; index++) {
+    dict_write_int32(iter, argKeys[index], record->args[index]);
+  }
+  
+  dict_write_end(iter);
+  if (app_message_outbox_send() != APP_MSG_OK) {
+    return false;
+  }
+  
+  _sending = true;
+  return true;
+}
+
+void LogBufferSent() {
+  // The record may already have been flushed or overwritten while in flight.
+  if (_sending) {
+    popRecord();
+  }
+  
+  _sendRetries = 0;
+  LogBufferSendNext();
+}
+
+void LogBufferSendFailed() {
+  _sending = false;
+  
+  // Resend the same record a few times before giving up on the stream.
+  if (_sendRetries < LOG_SEND_RETRIES) {
+    _sendRetries++;
+    LogBufferSendNext();
+    
+  } else {
+    _sendRetries = 0;
+    _phoneWaiting = false;
+  }
+}
+
+void LogBufferDestroy() {
+  if (_flushTimer != NULL) {
+    app_timer_cancel(_flushTimer);
+    _flushTimer = NULL;
+  }
+  
+  LogBufferFlush();
+}
+
+static void flushTimerCallback(void *callback_data) {
+  _flushTimer = NULL;
+  LogBufferFlush();
+}
+
+static LogRecord* peekRecord() {
+  return (_count == 0) ? NULL : &_records[_head];
+}
+
+static void popRecord() {
+  if (_count > 0) {
+    _head = (_head + 1) % LOG_BUFFER_SIZE;
+    _count--;
+    _sending = false;
+  }
+}
+
+#else
+
+void LogBufferFlush() {
+}
+
+void LogBufferStartSend() {
+}
+
+bool LogBufferSendNext() {
+  return false;
+}
+
+void LogBufferSent() {
+}
+
+void LogBufferSendFailed() {
+}
+
+void LogBufferDestroy() {
+}
+
+#endif
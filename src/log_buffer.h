@@ -0,0 +1,30 @@
+#pragma once
+#include "common.h"
+
+// AppMessage keys used to stream buffered log records to the phone.
+#define KEY_REQUEST_LOG 8
+#define KEY_LOG_FILE 9
+#define KEY_LOG_LINE 10
+#define KEY_LOG_FORMAT 11
+#define KEY_LOG_ARG0 12
+#define KEY_LOG_ARG1 13
+#define KEY_LOG_ARG2 14
+
+#define LOG_BUFFER_MAX_ARGS 3
+
+// Count the (at most LOG_BUFFER_MAX_ARGS) arguments passed to MY_APP_LOG.
+// Four to eight arguments expand to an undeclared identifier, so the build
+// fails instead of dropping arguments.
+#define LOG_ARG_COUNT(args...)                                             \
+  LOG_ARG_COUNT_(0, ## args, LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, \
+                 LOG_TOO_MANY_ARGS, LOG_TOO_MANY_ARGS, 3, 2, 1, 0)
+#define LOG_ARG_COUNT_(_0, _1, _2, _3, _4, _5, _6, _7, _8, count, ...) count
+#define LOG_TOO_MANY_ARGS MY_APP_LOG_takes_at_most_3_args
+
+void LogBufferWrite(uint8_t level, const char *file, uint16_t line, const char *fmt, uint8_t argCount, ...);
+void LogBufferFlush();
+void LogBufferStartSend();
+bool LogBufferSendNext();
+void LogBufferSent();
+void LogBufferSendFailed();
+void LogBufferDestroy();
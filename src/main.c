@@ -5,33 +5,20 @@
 #include "water_layer.h"
 #include "message_layer.h"
 #include "status_layer.h"
+#include "settings.h"
+#include "trace_recorder.h"
   
 #ifdef RUN_TEST
 #include "test_unit.h"
 #endif
 
-#define KEY_CURRENT_VERSION 0
-#define KEY_INSTALLED_VERSION 1
-#define KEY_HOUR_VIBRATE 2
-#define KEY_BLUETOOTH_VIBRATE 3
-#define KEY_HOUR_VIBRATE_START 4
-#define KEY_HOUR_VIBRATE_END 5
-#define KEY_CLOCK_24_HOUR 6
-#define KEY_REQUEST_SETUP_INFO 7
-  
+// Fail the build if the layer data no longer fits in the layer arena.
+typedef char LayerArenaSizeCheck[(ARENA_ALIGN(sizeof(MarkerLayerData)) + ARENA_ALIGN(sizeof(HourLayerData)) +
+                                  ARENA_ALIGN(sizeof(WaterLayerData)) + ARENA_ALIGN(sizeof(MessageLayerData)) +
+                                  ARENA_ALIGN(sizeof(StatusLayerData)) <= LAYER_ARENA_SIZE) ? 1 : -1];
+
 #define MESSAGE_SETTINGS_DURATION 1500
 #define MESSAGE_BLUETOOTH_DURATION 5000
-  
-// Last version of settings that did not contain hour range configuration for hourly vibrate.
-#define NO_HOUR_RANGE_VERSION 12
-  
-typedef struct {
-  int32_t currentVersion;
-  int32_t hourVibrate;
-  int32_t hourVibrateStart;
-  int32_t hourVibrateEnd;
-  int32_t bluetoothVibrate;
-} Settings;
 
 static Window *_mainWindow = NULL;
 static MarkerLayerData *_markerData = NULL;
@@ -41,6 +28,10 @@ static MessageLayerData *_messageData = NULL;
 static StatusLayerData *_statusData = NULL;
 static Settings _settings;
 static AppTimer *_messageTimer = NULL;
+static bool _focused = true;
+
+// A disconnect arrived while unfocused; shown when focus returns.
+static bool _bluetoothMessagePending = false;
 
 // Message window strings
 static const char *_settingsReceivedMsg = "Settings received!";
@@ -57,6 +48,7 @@ static void main_window_unload(Window *window);
 static void timer_handler(struct tm *tick_time, TimeUnits units_changed);
 static void bluetooth_service_handler(bool connected);
 static void battery_service_handler(BatteryChargeState charge_state);
+static void app_focus_handler(bool in_focus);
 static void inbox_received_callback(DictionaryIterator *iterator, void *context);
 static void inbox_dropped_callback(AppMessageResult reason, void *context);
 static void outbox_sent_callback(DictionaryIterator *values, void *context);
@@ -66,9 +58,11 @@ static void saveSettings(Settings *settings);
 static int32_t readPersistentInt(const uint32_t key, int32_t defaultValue);
 static bool isHourInRange(int16_t hour, int16_t start, int16_t end);
 static void sendSetupInfo();
+static void resumeExports();
 static void showMessage(const char *text, uint32_t duration);
 static void messageTimerCallback(void *callback_data);
 static void drawWatchFace();
+static void drawStatus();
 
 int main(void) {
   init();
@@ -77,6 +71,7 @@ int main(void) {
 }
 
 static void init() {
+  TraceLoad();
   loadSettings(&_settings);
   
 #ifdef RUN_TEST
@@ -107,6 +102,9 @@ static void init() {
   // Register battery service
   battery_state_service_subscribe(battery_service_handler);
   
+  // Register app focus service to stop drawing while obscured
+  app_focus_service_subscribe(app_focus_handler);
+  
   // Register AppMessage callbacks
   app_message_register_inbox_received(inbox_received_callback);
   app_message_register_inbox_dropped(inbox_dropped_callback);
@@ -120,6 +118,7 @@ static void init() {
 static void deinit() {
   bluetooth_connection_service_unsubscribe();
   battery_state_service_unsubscribe();
+  app_focus_service_unsubscribe();
   
   if (_messageTimer != NULL) {
     app_timer_cancel(_messageTimer);
@@ -137,6 +136,9 @@ static void deinit() {
     window_destroy(_mainWindow);
     _mainWindow = NULL;
   }
+  
+  TraceSave();
+  LogBufferDestroy();
 }
 
 static void main_window_load(Window *window) {
@@ -147,41 +149,40 @@ static void main_window_load(Window *window) {
   _statusData = CreateStatusLayer(window_get_root_layer(_mainWindow), CHILD);
   _hourData = CreateHourLayer(window_get_root_layer(_mainWindow), CHILD);
   _waterData = CreateWaterLayer(window_get_root_layer(_mainWindow), CHILD);
+  _messageData = CreateMessageLayer(window_get_root_layer(_mainWindow), CHILD);
   
-  // Initialize Bluetooth status
-  bool connected = bluetooth_connection_service_peek();
-  ShowBluetoothStatus(_statusData, !connected);
-  UpdateBluetoothStatus(_statusData, connected);
-  
-  // Initialize battery status
-  BatteryChargeState batteryState = battery_state_service_peek();
-  ShowBatteryStatus(_statusData, (batteryState.is_charging || batteryState.is_plugged));
-  UpdateBatteryStatus(_statusData, batteryState);
-  
+  drawStatus();
   drawWatchFace();
 }
 
 static void main_window_unload(Window *window) {
-  if (_messageData != NULL) {
-    DestroyMessageLayer(_messageData);
-    _messageData = NULL;
-  }
+  DestroyMessageLayer(_messageData);
+  _messageData = NULL;
   
   DestroyWaterLayer(_waterData);
   _waterData = NULL;
   
   DestroyHourLayer(_hourData);
   _hourData = NULL;
+  DestroyBitmapCache();
   
   DestroyStatusLayer(_statusData);
   _statusData = NULL;
   
   DestroyMarkerLayer(_markerData);
   _markerData = NULL;
+  
+  // All layer data lives in the arena, so release it in one go.
+  ArenaReset();
 }
 
 static void timer_handler(struct tm *tick_time, TimeUnits units_changed) {
-  drawWatchFace();
+  TraceEvent(TRACE_TICK, units_changed);
+  
+  // Nothing to draw while obscured. Focus regain catches up.
+  if (_focused) {
+    drawWatchFace();
+  }
   
 #ifndef RUN_TEST
   // Check for hourly vibrate
@@ -195,6 +196,7 @@ static void timer_handler(struct tm *tick_time, TimeUnits units_changed) {
 
 static void inbox_received_callback(DictionaryIterator *iterator, void *context) {
   Tuple *tuple = dict_read_first(iterator);
+  TraceEvent(TRACE_INBOX_RECEIVED, (tuple != NULL) ? tuple->key : 0);
   
   // Check for setup info request from phone.
   if (tuple != NULL && tuple->key == KEY_REQUEST_SETUP_INFO) {
@@ -202,6 +204,18 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
     sendSetupInfo();
     return;
   }
+  
+  // Check for trace export request from phone.
+  if (tuple != NULL && tuple->key == KEY_REQUEST_TRACE) {
+    TraceStartExport();
+    return;
+  }
+  
+  // Check for buffered log request from phone.
+  if (tuple != NULL && tuple->key == KEY_REQUEST_LOG) {
+    LogBufferStartSend();
+    return;
+  }
 
   while (tuple != NULL) {
     switch (tuple->key) {
@@ -243,11 +257,17 @@ static void inbox_received_callback(DictionaryIterator *iterator, void *context)
 }
 
 static void inbox_dropped_callback(AppMessageResult reason, void *context) {
+  TraceEvent(TRACE_INBOX_DROPPED, reason);
 }
 
 static void outbox_sent_callback(DictionaryIterator *values, void *context) {
   Tuple *tuple = dict_read_first(values);
   
+  // Trace and log exports are not traced themselves.
+  if (tuple != NULL && tuple->key != KEY_TRACE_INDEX && tuple->key != KEY_LOG_FILE) {
+    TraceEvent(TRACE_OUTBOX_SENT, tuple->key);
+  }
+  
   while (tuple != NULL) {
     switch (tuple->key) {
       case KEY_CLOCK_24_HOUR:
@@ -260,6 +280,25 @@ static void outbox_sent_callback(DictionaryIterator *values, void *context) {
         MY_APP_LOG(APP_LOG_LEVEL_INFO, "Successfully sent installed version %i to phone", (int) tuple->value->int32);
         break;
       
+      case KEY_LOG_FILE:
+        // Keep streaming buffered log records until none are left.
+        LogBufferSent();
+        break;
+      
+      case KEY_TRACE_INDEX:
+        // Keep exporting the trace until all records are sent.
+        TraceSent();
+        break;
+      
+      case KEY_TRACE_COUNT:
+      case KEY_TRACE_DATA:
+      case KEY_LOG_LINE:
+      case KEY_LOG_FORMAT:
+      case KEY_LOG_ARG0:
+      case KEY_LOG_ARG1:
+      case KEY_LOG_ARG2:
+        break;
+      
       default:
         MY_APP_LOG(APP_LOG_LEVEL_ERROR, "Key %i not recognized", (int) tuple->key);
         break;
@@ -267,18 +306,47 @@ static void outbox_sent_callback(DictionaryIterator *values, void *context) {
 
     tuple = dict_read_next(values);
   }
+  
+  resumeExports();
 }
 
 static void outbox_failed_callback(DictionaryIterator *failed, AppMessageResult reason, void *context) {
+  TraceEvent(TRACE_OUTBOX_FAILED, reason);
   MY_APP_LOG(APP_LOG_LEVEL_INFO, "outbox_failed_callback");
+  
+  Tuple *tuple = dict_read_first(failed);
+  if (tuple != NULL && tuple->key == KEY_LOG_FILE) {
+    LogBufferSendFailed();
+    
+  } else if (tuple != NULL && tuple->key == KEY_TRACE_INDEX) {
+    TraceSendFailed();
+  }
+  
+  resumeExports();
+}
+
+// A log or trace export requested while the outbox was busy starts once it
+// is free. Both are no-ops when nothing is waiting or the outbox is in use.
+static void resumeExports() {
+  TraceSendNext();
+  LogBufferSendNext();
 }
 
 static void bluetooth_service_handler(bool connected) {
+  TraceEvent(TRACE_BLUETOOTH, connected);
+  
+  // The alert still fires while obscured, but the display is left alone.
+  if (connected == false && _settings.bluetoothVibrate) {
+    vibes_short_pulse(); 
+  }
+  
+  if (_focused == false) {
+    _bluetoothMessagePending = (connected == false);
+    return;
+  }
+  
   if (connected == false) {
     showMessage(_bluetoothDisconnectMsg, MESSAGE_BLUETOOTH_DURATION);
-    if (_settings.bluetoothVibrate) {
-      vibes_short_pulse(); 
-    }
   }
   
   ShowBluetoothStatus(_statusData, !connected);
@@ -286,10 +354,37 @@ static void bluetooth_service_handler(bool connected) {
 }
 
 static void battery_service_handler(BatteryChargeState charge_state) {
+  TraceEvent(TRACE_BATTERY, charge_state.charge_percent | (charge_state.is_charging ? 0x100 : 0));
+  
+  if (_focused == false) {
+    return;
+  }
+  
   ShowBatteryStatus(_statusData, (charge_state.is_charging || charge_state.is_plugged));
   UpdateBatteryStatus(_statusData, charge_state);
 }
 
+static void app_focus_handler(bool in_focus) {
+  TraceEvent(TRACE_FOCUS, in_focus);
+  _focused = in_focus;
+  
+  if (in_focus == false) {
+    // Stop animating under the notification; redraw the current state on return.
+    SuspendWaterLayer(_waterData);
+    TraceCheckpoint();
+    
+  } else {
+    drawStatus();
+    drawWatchFace();
+    
+    // Only while still disconnected; a reconnect in the meantime cleared it.
+    if (_bluetoothMessagePending) {
+      _bluetoothMessagePending = false;
+      showMessage(_bluetoothDisconnectMsg, MESSAGE_BLUETOOTH_DURATION);
+    }
+  }
+}
+
 static void loadSettings(Settings *settings) {
   settings->currentVersion = readPersistentInt(KEY_CURRENT_VERSION, 0);
   settings->hourVibrate = readPersistentInt(KEY_HOUR_VIBRATE, 0);
@@ -361,8 +456,7 @@ static void sendSetupInfo() {
 static void messageTimerCallback(void *callback_data) {
   _messageTimer = NULL;
   if (_messageData != NULL) {
-    DestroyMessageLayer(_messageData);
-    _messageData = NULL;
+    ShowMessageLayer(_messageData, false);
   }
 }
 
@@ -377,11 +471,22 @@ static void showMessage(const char *text, uint32_t duration) {
     _messageTimer = app_timer_register(duration, messageTimerCallback, NULL);
   }
   
-  if (_messageData == NULL) {
-    _messageData = CreateMessageLayer(window_get_root_layer(_mainWindow), CHILD);
+  if (_messageData != NULL) {
+    DrawMessageLayer(_messageData, text);
+    ShowMessageLayer(_messageData, true);
   }
+}
+
+static void drawStatus() {
+  // Bluetooth status
+  bool connected = bluetooth_connection_service_peek();
+  ShowBluetoothStatus(_statusData, !connected);
+  UpdateBluetoothStatus(_statusData, connected);
   
-  DrawMessageLayer(_messageData, text);
+  // Battery status
+  BatteryChargeState batteryState = battery_state_service_peek();
+  ShowBatteryStatus(_statusData, (batteryState.is_charging || batteryState.is_plugged));
+  UpdateBatteryStatus(_statusData, batteryState);
 }
 
 static void drawWatchFace() {
@@ -394,9 +499,10 @@ static void drawWatchFace() {
   struct tm* localNow = localtime(&now);
   uint16_t hour = localNow->tm_hour;
   uint16_t minute = localNow->tm_min;
+  uint16_t second = localNow->tm_sec;
   
   DrawMarkerLayer(_markerData, hour, minute);
   DrawStatusLayer(_statusData, hour, minute);
   DrawHourLayer(_hourData, hour, minute);
-  DrawWaterLayer(_waterData, hour, minute);
+  DrawWaterLayer(_waterData, hour, minute, second);
 }
@@ -9,7 +9,7 @@
 static void markerLayerUpdateProc(Layer *layer, GContext *ctx);
 
 MarkerLayerData* CreateMarkerLayer(Layer* relativeLayer, LayerRelation relation) {
-  MarkerLayerData* data = malloc(sizeof(MarkerLayerData));
+  MarkerLayerData* data = ArenaAlloc(sizeof(MarkerLayerData));
   if (data != NULL) {
     data->layer = layer_create(GRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT));
     layer_set_update_proc(data->layer, markerLayerUpdateProc);
@@ -29,8 +29,6 @@ void DestroyMarkerLayer(MarkerLayerData* data) {
       layer_destroy(data->layer);
       data->layer = NULL;
     }
-    
-    free(data);
   }
 }
 
@@ -7,10 +7,8 @@
 static void borderLayerUpdateProc(Layer *layer, GContext *ctx);
 
 MessageLayerData* CreateMessageLayer(Layer *relativeLayer, LayerRelation relation) {
-  MessageLayerData *data = malloc(sizeof(MessageLayerData));
+  MessageLayerData *data = ArenaAlloc(sizeof(MessageLayerData));
   if (data != NULL) {
-    memset(data, 0, sizeof(MessageLayerData));
-    
     data->borderLayer = layer_create(GRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT));
     layer_set_update_proc(data->borderLayer, borderLayerUpdateProc);
     AddLayer(relativeLayer, data->borderLayer, relation);
@@ -19,6 +17,9 @@ MessageLayerData* CreateMessageLayer(Layer *relativeLayer, LayerRelation relatio
   	text_layer_set_font(data->textLayer, fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD));
   	text_layer_set_text_alignment(data->textLayer, GTextAlignmentCenter);
     AddLayer(relativeLayer, (Layer*) data->textLayer, relation);
+    
+    // Created once and kept hidden until there is a message to show.
+    ShowMessageLayer(data, false);
   }
   
   return data;
@@ -28,6 +29,11 @@ void DrawMessageLayer(MessageLayerData *data, const char *text) {
 	text_layer_set_text(data->textLayer, text);  
 }
 
+void ShowMessageLayer(MessageLayerData *data, bool show) {
+  layer_set_hidden(data->borderLayer, (show == false));
+  layer_set_hidden((Layer*) data->textLayer, (show == false));
+}
+
 void DestroyMessageLayer(MessageLayerData *data) {
   if (data != NULL) {
     if (data->textLayer != NULL) {
@@ -39,8 +45,6 @@ void DestroyMessageLayer(MessageLayerData *data) {
       layer_destroy(data->borderLayer);
       data->borderLayer = NULL;
     }
-    
-    free(data);
   }
 }
 
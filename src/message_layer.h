@@ -8,4 +8,5 @@ typedef struct {
 
 MessageLayerData* CreateMessageLayer(Layer *relativeLayer, LayerRelation relation);
 void DrawMessageLayer(MessageLayerData *data, const char *text);
+void ShowMessageLayer(MessageLayerData *data, bool show);
 void DestroyMessageLayer(MessageLayerData *data);
\ No newline at end of file
@@ -1,10 +1,28 @@
 var CONSOLE_LOG = false;
+// Request buffered log records from a LOGGING_ON build of the watchface.
+var REQUEST_LOG = false;
+// Request the event trace recorded by a TRACE_ON (profile) build of the watchface.
+// Replay the logged dump with tools/host/trace_replay.
+var REQUEST_TRACE = false;
+var TRACE_RECORD_SIZE = 8;
+var TRACE_TYPES = ["start", "stop", "tick", "bluetooth", "battery", "inbox received", "inbox dropped",
+                   "outbox sent", "outbox failed", "animation start", "animation stop", "focus"];
+var _traceBytes = [];
+var _traceNextIndex = 0;
 var _showConfiguration = false;
 
 Pebble.addEventListener("ready",
   function(e) {
     consoleLog("Event listener - ready");
     _showConfiguration = false;
+    
+    if (REQUEST_LOG) {
+      requestLog();
+    }
+    
+    if (REQUEST_TRACE) {
+      requestTrace();
+    }
   }
 );
 
@@ -14,6 +32,16 @@ Pebble.addEventListener("appmessage",
     
     consoleLog("Event listener - appmessage");
 
+    if (typeof(e.payload.KEY_LOG_FORMAT) !== "undefined") {
+      console.log(formatLogRecord(e.payload));
+      return;
+    }
+
+    if (typeof(e.payload.KEY_TRACE_DATA) !== "undefined") {
+      receiveTrace(e.payload);
+      return;
+    }
+
     if (typeof(e.payload.KEY_INSTALLED_VERSION) !== "undefined") {
       localStorage.setItem("installedVersion", parseInt(e.payload.KEY_INSTALLED_VERSION));  
       message = "Installed version is " + e.payload.KEY_INSTALLED_VERSION;
@@ -124,6 +152,96 @@ function getLocalInt(name, defaultValue) {
   return localValue;
 }
 
+function requestLog() {
+  var dictionary = {
+    "KEY_REQUEST_LOG" : 0
+  };
+
+  Pebble.sendAppMessage(dictionary,
+    function(e) {
+      consoleLog("Log request successfully sent to Pebble");
+    },
+    function(e) {
+      consoleLog("Error sending log request to Pebble");
+    }
+  );
+}
+
+function formatLogRecord(payload) {
+  var args = [payload.KEY_LOG_ARG0, payload.KEY_LOG_ARG1, payload.KEY_LOG_ARG2];
+  var index = 0;
+  var text = payload.KEY_LOG_FORMAT.replace(/%(%|[-0-9]*[dicux])/g, function(match, spec) {
+    if (spec == "%") {
+      return "%";
+    }
+    
+    return String(args[index++]);
+  });
+  
+  return payload.KEY_LOG_FILE + ":" + payload.KEY_LOG_LINE + " " + text;
+}
+
+function requestTrace() {
+  var dictionary = {
+    "KEY_REQUEST_TRACE" : 0
+  };
+
+  _traceBytes = [];
+  _traceNextIndex = 0;
+  Pebble.sendAppMessage(dictionary,
+    function(e) {
+      consoleLog("Trace request successfully sent to Pebble");
+    },
+    function(e) {
+      consoleLog("Error sending trace request to Pebble");
+    }
+  );
+}
+
+function receiveTrace(payload) {
+  // The watch resends a chunk whose ack was lost, so skip one already received.
+  if (payload.KEY_TRACE_INDEX < _traceNextIndex) {
+    return;
+  }
+  
+  _traceBytes = _traceBytes.concat(payload.KEY_TRACE_DATA);
+  
+  var received = payload.KEY_TRACE_INDEX + (payload.KEY_TRACE_DATA.length / TRACE_RECORD_SIZE);
+  _traceNextIndex = received;
+  if (received < payload.KEY_TRACE_COUNT) {
+    return;
+  }
+  
+  // Raw dump for attaching to bug reports, followed by the decoded timeline.
+  var hex = _traceBytes.map(function(value) {
+    return ("0" + (value & 0xFF).toString(16)).slice(-2);
+  }).join("");
+  console.log("Trace " + hex);
+  
+  var lastTime = null;
+  for (var offset = 0; offset + TRACE_RECORD_SIZE <= _traceBytes.length; offset += TRACE_RECORD_SIZE) {
+    var record = decodeTraceRecord(_traceBytes, offset);
+    var delta = (lastTime === null) ? 0 : (record.time - lastTime);
+    lastTime = record.time;
+    console.log("Trace " + new Date(record.time).toISOString() + " +" + delta + "ms " +
+                (TRACE_TYPES[record.type] || ("type " + record.type)) + " " + record.value);
+  }
+  
+  _traceBytes = [];
+}
+
+// Little-endian { uint32 seconds; uint16 type << 10 | ms; uint16 value }.
+function decodeTraceRecord(bytes, offset) {
+  var seconds = (bytes[offset] | (bytes[offset + 1] << 8) | (bytes[offset + 2] << 16) | (bytes[offset + 3] << 24)) >>> 0;
+  var typeMs = bytes[offset + 4] | (bytes[offset + 5] << 8);
+  
+  return {
+    time: (seconds * 1000) + (typeMs & 0x3FF),
+    type: typeMs >> 10,
+    value: bytes[offset + 6] | (bytes[offset + 7] << 8)
+  };
+}
+
 function consoleLog(message) {
   if (CONSOLE_LOG) {
     console.log(message);
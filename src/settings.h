@@ -0,0 +1,26 @@
+#pragma once
+// Persisted settings and their AppMessage keys. Also included by the host
+// tools (tools/host), so only plain definitions belong here.
+
+#define KEY_CURRENT_VERSION 0
+#define KEY_INSTALLED_VERSION 1
+#define KEY_HOUR_VIBRATE 2
+#define KEY_BLUETOOTH_VIBRATE 3
+#define KEY_HOUR_VIBRATE_START 4
+#define KEY_HOUR_VIBRATE_END 5
+#define KEY_CLOCK_24_HOUR 6
+#define KEY_REQUEST_SETUP_INFO 7
+// Keys 8-14 are reserved for the log buffer (see log_buffer.h), 15-18 for the
+// trace recorder (see trace_recorder.h), which also persists keys 20-22.
+  
+// Last version of settings that did not contain hour range configuration for hourly vibrate.
+#define NO_HOUR_RANGE_VERSION 12
+
+  
+typedef struct {
+  int32_t currentVersion;
+  int32_t hourVibrate;
+  int32_t hourVibrateStart;
+  int32_t hourVibrateEnd;
+  int32_t bluetoothVibrate;
+} Settings;
\ No newline at end of file
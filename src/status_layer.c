@@ -1,26 +1,57 @@
 #include <pebble.h>
 #include "status_layer.h"
-  
-static char _batteryText[20];
-static char _bluetoothConnected[] = "Connected";
-static char _bluetoothDisconnected[] = "Disconnected";
+
+// The glyphs are a 5x9 pixel font of their own, not FONT_KEY_GOTHIC_14, so the
+// status line looks plainer than the old text. It keeps the old line's height,
+// which keeps the redrawn area small.
+#define STATUS_HEIGHT 18
+#define GLYPH_TOP 4
+#define GLYPH_HEIGHT 9
+#define GLYPH_SPACING 1
+#define BLUETOOTH_LEFT 10
+#define BATTERY_RIGHT 139
+
+typedef struct {
+  uint8_t left;
+  uint8_t width;
+} StatusGlyphSpan;
+
+// Generated by tools/status_glyphs.py along with resources/images/status_glyphs.png.
+static const StatusGlyphSpan _glyphSpans[GLYPH_COUNT] = {
+  { 0, 5 }, // 0
+  { 6, 5 }, // 1
+  { 12, 5 }, // 2
+  { 18, 5 }, // 3
+  { 24, 5 }, // 4
+  { 30, 5 }, // 5
+  { 36, 5 }, // 6
+  { 42, 5 }, // 7
+  { 48, 5 }, // 8
+  { 54, 5 }, // 9
+  { 60, 6 }, // %
+  { 67, 50 }, // Connected
+  { 118, 62 }, // Disconnected
+};
+
+static void statusLayerUpdateProc(Layer *layer, GContext *ctx);
+static int16_t drawGlyph(StatusLayerData *data, GContext *ctx, StatusGlyph glyph, int16_t left);
 
 StatusLayerData* CreateStatusLayer(Layer *relativeLayer, LayerRelation relation) {
-  StatusLayerData *data = malloc(sizeof(StatusLayerData));
+  StatusLayerData *data = ArenaAlloc(sizeof(StatusLayerData));
   if (data != NULL) {
-    memset(data, 0, sizeof(StatusLayerData));
-    
-    data->textLayerBattery = text_layer_create(GRect(107, 0, 36, 34));
-  	text_layer_set_font(data->textLayerBattery, fonts_get_system_font(FONT_KEY_GOTHIC_14));
-  	text_layer_set_text_alignment(data->textLayerBattery, GTextAlignmentRight);
-    text_layer_set_background_color(data->textLayerBattery, GColorClear);
-    AddLayer(relativeLayer, (Layer*) data->textLayerBattery, relation);
+    // Decode the strip once; drawing is then only bitmap copies.
+    data->glyphStrip = gbitmap_create_with_resource(RESOURCE_ID_IMAGE_STATUS_GLYPHS);
+    if (data->glyphStrip != NULL) {
+      for (int glyph = 0; glyph < GLYPH_COUNT; glyph++) {
+        data->glyphs[glyph] = gbitmap_create_as_sub_bitmap(data->glyphStrip,
+          GRect(_glyphSpans[glyph].left, 0, _glyphSpans[glyph].width, GLYPH_HEIGHT));
+      }
+    }
     
-    data->textLayerBluetooth = text_layer_create(GRect(10, 0, 96, 34));
-  	text_layer_set_font(data->textLayerBluetooth, fonts_get_system_font(FONT_KEY_GOTHIC_14));
-  	text_layer_set_text_alignment(data->textLayerBluetooth, GTextAlignmentLeft);
-    text_layer_set_background_color(data->textLayerBluetooth, GColorClear);
-    AddLayer(relativeLayer, (Layer*) data->textLayerBluetooth, relation);
+    data->layer = layer_create_with_data(GRect(0, 0, SCREEN_WIDTH, STATUS_HEIGHT), sizeof(StatusLayerData*));
+    *(StatusLayerData**) layer_get_data(data->layer) = data;
+    layer_set_update_proc(data->layer, statusLayerUpdateProc);
+    AddLayer(relativeLayer, data->layer, relation);
   }
   
   return data;
@@ -32,33 +63,99 @@ void DrawStatusLayer(StatusLayerData *data, uint16_t hour, uint16_t minute) {
 
 void DestroyStatusLayer(StatusLayerData *data) {
   if (data != NULL) {
-    if (data->textLayerBattery != NULL) {
-      text_layer_destroy(data->textLayerBattery);
-      data->textLayerBattery = NULL;
+    if (data->layer != NULL) {
+      layer_destroy(data->layer);
+      data->layer = NULL;
     }
     
-    if (data->textLayerBluetooth != NULL) {
-      text_layer_destroy(data->textLayerBluetooth);
-      data->textLayerBluetooth = NULL;
+    for (int glyph = 0; glyph < GLYPH_COUNT; glyph++) {
+      if (data->glyphs[glyph] != NULL) {
+        gbitmap_destroy(data->glyphs[glyph]);
+        data->glyphs[glyph] = NULL;
+      }
     }
     
-    free(data);
+    if (data->glyphStrip != NULL) {
+      gbitmap_destroy(data->glyphStrip);
+      data->glyphStrip = NULL;
+    }
   }
 }
 
 void UpdateBatteryStatus(StatusLayerData *data, BatteryChargeState charge_state) {
-  snprintf(_batteryText, sizeof(_batteryText), "%d%% ", charge_state.charge_percent);
-  text_layer_set_text(data->textLayerBattery, _batteryText);
+  if (data->batteryPercent != charge_state.charge_percent) {
+    data->batteryPercent = charge_state.charge_percent;
+    layer_mark_dirty(data->layer);
+  }
 }
 
 void ShowBatteryStatus(StatusLayerData *data, bool show) {
-  layer_set_hidden((Layer*) data->textLayerBattery, (show == false));
+  if (data->showBattery != show) {
+    data->showBattery = show;
+    layer_mark_dirty(data->layer);
+  }
 }
 
 void UpdateBluetoothStatus(StatusLayerData *data, bool connected) {
-  text_layer_set_text(data->textLayerBluetooth, connected ? _bluetoothConnected : _bluetoothDisconnected);  
+  if (data->connected != connected) {
+    data->connected = connected;
+    layer_mark_dirty(data->layer);
+  }
 }
 
 void ShowBluetoothStatus(StatusLayerData *data, bool show) {
-  layer_set_hidden((Layer*) data->textLayerBluetooth, (show == false));
+  if (data->showBluetooth != show) {
+    data->showBluetooth = show;
+    layer_mark_dirty(data->layer);
+  }
+}
+
+static void statusLayerUpdateProc(Layer *layer, GContext *ctx) {
+  StatusLayerData *data = *(StatusLayerData**) layer_get_data(layer);
+  if (data->glyphStrip == NULL) {
+    return;
+  }
+  
+  // Black glyphs on white, like the hour digits, so the markers and water show through.
+  graphics_context_set_compositing_mode(ctx, GCompOpAnd);
+  
+  if (data->showBluetooth) {
+    drawGlyph(data, ctx, data->connected ? GLYPH_CONNECTED : GLYPH_DISCONNECTED, BLUETOOTH_LEFT);
+  }
+  
+  if (data->showBattery) {
+    // Right align the percentage, at most "100%".
+    StatusGlyph glyphs[4];
+    int count = 0;
+    int16_t width = _glyphSpans[GLYPH_PERCENT].width;
+    
+    if (data->batteryPercent >= 100) {
+      glyphs[count++] = data->batteryPercent / 100;
+    }
+    
+    if (data->batteryPercent >= 10) {
+      glyphs[count++] = (data->batteryPercent / 10) % 10;
+    }
+    
+    glyphs[count++] = data->batteryPercent % 10;
+    glyphs[count++] = GLYPH_PERCENT;
+    
+    for (int index = 0; index < count - 1; index++) {
+      width += _glyphSpans[glyphs[index]].width + GLYPH_SPACING;
+    }
+    
+    int16_t left = BATTERY_RIGHT - width;
+    for (int index = 0; index < count; index++) {
+      left = drawGlyph(data, ctx, glyphs[index], left);
+    }
+  }
+}
+
+// Draw one glyph with its top left at (left, GLYPH_TOP) and return where the next one starts.
+static int16_t drawGlyph(StatusLayerData *data, GContext *ctx, StatusGlyph glyph, int16_t left) {
+  if (data->glyphs[glyph] != NULL) {
+    graphics_draw_bitmap_in_rect(ctx, data->glyphs[glyph], GRect(left, GLYPH_TOP, _glyphSpans[glyph].width, GLYPH_HEIGHT));
+  }
+  
+  return left + _glyphSpans[glyph].width + GLYPH_SPACING;
 }
\ No newline at end of file
@@ -1,9 +1,21 @@
 #pragma once
 #include "common.h"
 
+// Glyphs in RESOURCE_ID_IMAGE_STATUS_GLYPHS: the digits 0-9 at their own
+// values, then "%" and the two Bluetooth words.
+typedef enum { GLYPH_PERCENT = 10, GLYPH_CONNECTED, GLYPH_DISCONNECTED, GLYPH_COUNT } StatusGlyph;
+
 typedef struct {
-  TextLayer *textLayerBluetooth;
-  TextLayer *textLayerBattery;
+  Layer *layer;
+  
+  // The decoded strip, and one sub-bitmap per glyph sharing its pixels.
+  GBitmap *glyphStrip;
+  GBitmap *glyphs[GLYPH_COUNT];
+  
+  uint8_t batteryPercent;
+  bool showBattery;
+  bool showBluetooth;
+  bool connected;
 } StatusLayerData;
 
 StatusLayerData* CreateStatusLayer(Layer *relativeLayer, LayerRelation relation);
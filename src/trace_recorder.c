@@ -0,0 +1,185 @@
+#include <pebble.h>
+#include "trace_recorder.h"
+
+#ifdef TRACE_ON
+
+// Persisted in two PERSIST_DATA_MAX_LENGTH chunks, plus the running total.
+#define TRACE_SIZE 64
+#define TRACE_CHUNK_RECORDS (PERSIST_DATA_MAX_LENGTH / sizeof(TraceRecord))
+#define TRACE_EXPORT_RECORDS 16
+#define TRACE_SEND_RETRIES 3
+
+#define PERSIST_TRACE_TOTAL 20
+#define PERSIST_TRACE_DATA 21
+
+// Type in the top 6 bits, milliseconds in the low 10.
+#define TRACE_TYPE_MS(type, ms) ((uint16_t) (((type) << 10) | ((ms) & 0x3FF)))
+
+// 8 bytes per record, little-endian, decoded by pebble-js-app.js.
+typedef struct {
+  uint32_t time;
+  uint16_t typeMs;
+  uint16_t value;
+} TraceRecord;
+
+static TraceRecord _trace[TRACE_SIZE];
+static uint32_t _traceTotal = 0;
+
+static void persistChunk(uint32_t recordIndex);
+static uint32_t _exportNext = 0;
+static uint32_t _exportEnd = 0;
+
+// Records of the chunk handed to the outbox and waiting for its ack.
+static uint16_t _exportSending = 0;
+static uint8_t _sendRetries = 0;
+
+void TraceLoad() {
+  if (persist_exists(PERSIST_TRACE_TOTAL)) {
+    _traceTotal = persist_read_int(PERSIST_TRACE_TOTAL);
+    
+    for (uint16_t chunk = 0; chunk < TRACE_SIZE / TRACE_CHUNK_RECORDS; chunk++) {
+      persist_read_data(PERSIST_TRACE_DATA + chunk, &_trace[chunk * TRACE_CHUNK_RECORDS], PERSIST_DATA_MAX_LENGTH);
+    }
+  }
+  
+  TraceEvent(TRACE_START, 0);
+}
+
+void TraceEvent(TraceType type, uint16_t value) {
+  time_t now;
+  uint16_t ms;
+  time_ms(&now, &ms);
+  
+  TraceRecord *record = &_trace[_traceTotal % TRACE_SIZE];
+  record->time = now;
+  record->typeMs = TRACE_TYPE_MS(type, ms);
+  record->value = value;
+  _traceTotal++;
+  
+  // Write each chunk as it fills, so a crash, watchdog reset or dead battery
+  // loses at most the records since the last full chunk or checkpoint.
+  if (_traceTotal % TRACE_CHUNK_RECORDS == 0) {
+    persistChunk(_traceTotal - 1);
+  }
+}
+
+// Write the chunk being filled, e.g. when a notification covers the face.
+void TraceCheckpoint() {
+  if (_traceTotal % TRACE_CHUNK_RECORDS != 0) {
+    persistChunk(_traceTotal - 1);
+  }
+}
+
+void TraceSave() {
+  TraceEvent(TRACE_STOP, 0);
+  TraceCheckpoint();
+}
+
+// Export the records held at this moment. Records added while exporting,
+// including the export's own outbox results, are left for the next export.
+// If the outbox is busy, the export starts from the next TraceSendNext.
+void TraceStartExport() {
+  _exportEnd = _traceTotal;
+  _exportNext = (_traceTotal > TRACE_SIZE) ? (_traceTotal - TRACE_SIZE) : 0;
+  _exportSending = 0;
+  _sendRetries = 0;
+  TraceSendNext();
+}
+
+// Send the next chunk of the export. Returns false when the export is
+// finished, a chunk is already in flight or the outbox is busy. The export
+// only moves past a chunk in TraceSent, so call again whenever the outbox
+// frees up.
+bool TraceSendNext() {
+  if (_exportSending > 0) {
+    return false;
+  }
+  
+  // Skip records overwritten since the export started.
+  if (_traceTotal > TRACE_SIZE && _exportNext < _traceTotal - TRACE_SIZE) {
+    _exportNext = _traceTotal - TRACE_SIZE;
+  }
+  
+  if (_exportNext >= _exportEnd) {
+    return false;
+  }
+  
+  DictionaryIterator *iter;
+  app_message_outbox_begin(&iter);
+
+  if (iter == NULL) {
+    return false;
+  }
+  
+  TraceRecord records[TRACE_EXPORT_RECORDS];
+  uint16_t count = 0;
+  while (count < TRACE_EXPORT_RECORDS && _exportNext + count < _exportEnd) {
+    records[count] = _trace[(_exportNext + count) % TRACE_SIZE];
+    count++;
+  }
+  
+  // KEY_TRACE_INDEX goes first so the outbox sent callback recognizes the export.
+  dict_write_int32(iter, KEY_TRACE_INDEX, _exportNext);
+  dict_write_int32(iter, KEY_TRACE_COUNT, _exportEnd);
+  dict_write_data(iter, KEY_TRACE_DATA, (uint8_t*) records, count * sizeof(TraceRecord));
+  dict_write_end(iter);
+  if (app_message_outbox_send() != APP_MSG_OK) {
+    return false;
+  }
+  
+  _exportSending = count;
+  return true;
+}
+
+void TraceSent() {
+  _exportNext += _exportSending;
+  _exportSending = 0;
+  _sendRetries = 0;
+  TraceSendNext();
+}
+
+void TraceSendFailed() {
+  _exportSending = 0;
+  
+  // Resend the same chunk a few times before giving up on the export.
+  if (_sendRetries < TRACE_SEND_RETRIES) {
+    _sendRetries++;
+    TraceSendNext();
+    
+  } else {
+    _sendRetries = 0;
+    _exportNext = _exportEnd;
+  }
+}
+
+static void persistChunk(uint32_t recordIndex) {
+  uint16_t chunk = (recordIndex % TRACE_SIZE) / TRACE_CHUNK_RECORDS;
+  persist_write_data(PERSIST_TRACE_DATA + chunk, &_trace[chunk * TRACE_CHUNK_RECORDS], PERSIST_DATA_MAX_LENGTH);
+  persist_write_int(PERSIST_TRACE_TOTAL, _traceTotal);
+}
+
+#else
+
+void TraceLoad() {
+}
+
+void TraceCheckpoint() {
+}
+
+void TraceSave() {
+}
+
+void TraceStartExport() {
+}
+
+bool TraceSendNext() {
+  return false;
+}
+
+void TraceSent() {
+}
+
+void TraceSendFailed() {
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+#include "common.h"
+
+// AppMessage keys used to export the trace to the phone.
+#define KEY_REQUEST_TRACE 15
+#define KEY_TRACE_INDEX 16
+#define KEY_TRACE_COUNT 17
+#define KEY_TRACE_DATA 18
+
+typedef enum {
+  TRACE_START,
+  TRACE_STOP,
+  TRACE_TICK,              // value = units_changed
+  TRACE_BLUETOOTH,         // value = connected
+  TRACE_BATTERY,           // value = charge percent, bit 8 set when charging
+  TRACE_INBOX_RECEIVED,    // value = first key
+  TRACE_INBOX_DROPPED,     // value = reason
+  TRACE_OUTBOX_SENT,       // value = first key
+  TRACE_OUTBOX_FAILED,     // value = reason
+  TRACE_ANIMATION_START,
+  TRACE_ANIMATION_STOP,    // value = finished
+  TRACE_FOCUS,             // value = in focus
+} TraceType;
+
+// Only TRACE_ON builds (the profile variant in wscript) record anything.
+// Elsewhere TraceEvent compiles away and the rest are empty stubs.
+#ifdef TRACE_ON
+void TraceEvent(TraceType type, uint16_t value);
+#else
+#define TraceEvent(type, value)
+#endif
+
+void TraceLoad();
+void TraceCheckpoint();
+void TraceSave();
+void TraceStartExport();
+bool TraceSendNext();
+void TraceSent();
+void TraceSendFailed();
\ No newline at end of file
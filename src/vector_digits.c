@@ -0,0 +1,194 @@
+#include <pebble.h>
+#include "vector_digits.h"
+
+#ifdef VECTOR_DIGITS
+
+// Each pen stroke is stored as its outline, one side of the pen and back along
+// the other, and filled with a single gpath_draw_filled. Rings are split into
+// two halves so no outline has a hole. That is 2-4 fills per digit.
+typedef struct {
+  int8_t x;
+  int8_t y;
+} DigitPoint;
+
+typedef struct {
+  uint16_t firstPoint;
+  uint8_t pointCount;
+} DigitPath;
+
+// Generated by tools/vector_digits.py from the shapes fitted to resources/images.
+// BEGIN GENERATED
+static const DigitPoint _digitPoints[696] = {
+  // 0
+  { 44, 42 }, { 44, 53 }, { 43, 60 }, { 43, 64 }, { 41, 68 }, { 40, 70 }, { 38, 72 }, { 37, 73 },
+  { 34, 74 }, { 29, 74 }, { 24, 74 }, { 21, 73 }, { 20, 72 }, { 18, 70 }, { 17, 68 }, { 15, 64 },
+  { 15, 60 }, { 14, 53 }, { 14, 42 }, { 3, 42 }, { 3, 54 }, { 4, 61 }, { 5, 67 }, { 7, 72 },
+  { 9, 76 }, { 13, 80 }, { 17, 83 }, { 22, 84 }, { 29, 84 }, { 36, 84 }, { 41, 83 }, { 45, 80 },
+  { 49, 76 }, { 51, 72 }, { 53, 67 }, { 54, 61 }, { 55, 54 }, { 55, 42 },
+  { 14, 42 }, { 14, 31 }, { 15, 24 }, { 15, 20 }, { 17, 16 }, { 18, 14 }, { 20, 12 }, { 21, 11 },
+  { 24, 10 }, { 29, 10 }, { 34, 10 }, { 37, 11 }, { 38, 12 }, { 40, 14 }, { 41, 16 }, { 43, 20 },
+  { 43, 24 }, { 44, 31 }, { 44, 42 }, { 55, 42 }, { 55, 30 }, { 54, 23 }, { 53, 17 }, { 51, 12 },
+  { 49, 8 }, { 45, 4 }, { 41, 1 }, { 36, 0 }, { 29, 0 }, { 22, 0 }, { 17, 1 }, { 13, 4 },
+  { 9, 8 }, { 7, 12 }, { 5, 17 }, { 4, 23 }, { 3, 30 }, { 3, 42 },
+  // 1
+  { 31, 0 }, { 31, 84 }, { 42, 84 }, { 42, 0 },
+  { 13, 12 }, { 36, 12 }, { 36, 2 }, { 13, 2 },
+  // 2
+  { 14, 24 }, { 14, 21 }, { 14, 18 }, { 15, 16 }, { 16, 14 }, { 18, 13 }, { 19, 11 }, { 21, 10 },
+  { 24, 9 }, { 27, 9 }, { 30, 9 }, { 32, 9 }, { 35, 10 }, { 37, 11 }, { 39, 13 }, { 40, 14 },
+  { 41, 16 }, { 42, 19 }, { 42, 21 }, { 42, 24 }, { 42, 27 }, { 42, 29 }, { 6, 74 }, { 14, 80 },
+  { 51, 33 }, { 52, 29 }, { 52, 25 }, { 52, 20 }, { 52, 16 }, { 50, 12 }, { 48, 9 }, { 45, 5 },
+  { 42, 3 }, { 39, 1 }, { 35, 0 }, { 31, 0 }, { 26, 0 }, { 22, 0 }, { 18, 1 }, { 14, 3 },
+  { 11, 5 }, { 8, 8 }, { 6, 12 }, { 4, 16 }, { 4, 20 }, { 4, 24 },
+  { 3, 84 }, { 55, 84 }, { 55, 75 }, { 3, 75 },
+  // 3
+  { 15, 23 }, { 15, 21 }, { 15, 18 }, { 16, 16 }, { 17, 14 }, { 19, 13 }, { 21, 11 }, { 23, 10 },
+  { 26, 9 }, { 29, 9 }, { 31, 9 }, { 34, 10 }, { 36, 10 }, { 39, 12 }, { 41, 13 }, { 42, 15 },
+  { 43, 17 }, { 44, 19 }, { 44, 22 }, { 44, 24 }, { 44, 26 }, { 43, 28 }, { 42, 30 }, { 40, 32 },
+  { 38, 34 }, { 36, 35 }, { 34, 36 }, { 31, 36 }, { 20, 36 }, { 20, 45 }, { 32, 46 }, { 36, 45 },
+  { 40, 44 }, { 44, 42 }, { 47, 39 }, { 50, 36 }, { 52, 33 }, { 54, 29 }, { 54, 25 }, { 54, 21 },
+  { 54, 17 }, { 52, 13 }, { 50, 9 }, { 48, 6 }, { 44, 3 }, { 41, 1 }, { 37, 0 }, { 33, 0 },
+  { 28, 0 }, { 24, 0 }, { 20, 1 }, { 16, 3 }, { 13, 5 }, { 10, 8 }, { 7, 11 }, { 6, 15 },
+  { 5, 19 }, { 5, 23 },
+  { 20, 45 }, { 36, 46 }, { 37, 47 }, { 40, 48 }, { 42, 50 }, { 43, 52 }, { 44, 55 }, { 45, 58 },
+  { 45, 60 }, { 45, 63 }, { 44, 65 }, { 43, 68 }, { 41, 70 }, { 39, 72 }, { 37, 73 }, { 35, 75 },
+  { 32, 75 }, { 29, 75 }, { 27, 75 }, { 24, 75 }, { 22, 73 }, { 20, 72 }, { 18, 70 }, { 16, 68 },
+  { 15, 65 }, { 14, 63 }, { 14, 60 }, { 4, 60 }, { 4, 64 }, { 6, 69 }, { 7, 73 }, { 10, 76 },
+  { 13, 79 }, { 17, 82 }, { 21, 84 }, { 25, 84 }, { 29, 84 }, { 34, 84 }, { 38, 84 }, { 42, 82 },
+  { 46, 80 }, { 49, 77 }, { 51, 73 }, { 53, 69 }, { 55, 65 }, { 55, 60 }, { 55, 56 }, { 54, 52 },
+  { 52, 48 }, { 49, 44 }, { 46, 41 }, { 43, 38 }, { 38, 36 }, { 20, 36 },
+  // 4
+  { 36, 0 }, { 36, 84 }, { 47, 84 }, { 47, 0 },
+  { 34, 1 }, { 2, 59 }, { 10, 63 }, { 42, 5 },
+  { 0, 65 }, { 59, 65 }, { 59, 56 }, { 0, 56 },
+  // 5
+  { 15, 10 }, { 51, 10 }, { 51, 0 }, { 15, 0 },
+  { 10, 4 }, { 5, 43 }, { 15, 44 }, { 20, 5 },
+  { 13, 49 }, { 25, 40 }, { 27, 39 }, { 31, 39 }, { 34, 40 }, { 36, 41 }, { 38, 42 }, { 40, 44 },
+  { 41, 46 }, { 42, 48 }, { 43, 51 }, { 43, 55 }, { 43, 60 }, { 43, 63 }, { 42, 66 }, { 40, 68 },
+  { 39, 70 }, { 37, 72 }, { 35, 73 }, { 33, 73 }, { 29, 74 }, { 25, 74 }, { 22, 73 }, { 20, 72 },
+  { 18, 71 }, { 17, 69 }, { 16, 67 }, { 14, 64 }, { 5, 67 }, { 6, 71 }, { 8, 75 }, { 11, 78 },
+  { 15, 81 }, { 19, 83 }, { 24, 84 }, { 29, 84 }, { 34, 84 }, { 39, 83 }, { 43, 81 }, { 46, 78 },
+  { 49, 74 }, { 51, 70 }, { 53, 66 }, { 54, 61 }, { 54, 55 }, { 53, 49 }, { 52, 45 }, { 50, 40 },
+  { 48, 37 }, { 45, 34 }, { 41, 31 }, { 37, 30 }, { 32, 29 }, { 26, 29 }, { 20, 30 }, { 7, 42 },
+  // 6
+  { 45, 57 }, { 45, 60 }, { 44, 63 }, { 43, 66 }, { 41, 69 }, { 39, 71 }, { 37, 73 }, { 35, 74 },
+  { 32, 75 }, { 30, 75 }, { 27, 75 }, { 24, 74 }, { 22, 73 }, { 20, 71 }, { 18, 69 }, { 16, 66 },
+  { 15, 63 }, { 14, 60 }, { 14, 57 }, { 4, 57 }, { 4, 62 }, { 5, 66 }, { 7, 71 }, { 10, 75 },
+  { 13, 78 }, { 17, 81 }, { 21, 83 }, { 25, 84 }, { 30, 84 }, { 34, 84 }, { 38, 83 }, { 42, 81 },
+  { 46, 78 }, { 49, 75 }, { 52, 71 }, { 54, 66 }, { 55, 62 }, { 55, 57 },
+  { 14, 57 }, { 14, 54 }, { 15, 51 }, { 16, 48 }, { 18, 45 }, { 20, 43 }, { 22, 41 }, { 24, 40 },
+  { 27, 39 }, { 29, 39 }, { 32, 39 }, { 35, 40 }, { 37, 41 }, { 39, 43 }, { 41, 45 }, { 43, 48 },
+  { 44, 51 }, { 45, 54 }, { 45, 57 }, { 55, 57 }, { 55, 52 }, { 54, 48 }, { 52, 43 }, { 49, 39 },
+  { 46, 36 }, { 42, 33 }, { 38, 31 }, { 34, 29 }, { 29, 29 }, { 25, 29 }, { 21, 31 }, { 17, 33 },
+  { 13, 36 }, { 10, 39 }, { 7, 43 }, { 5, 48 }, { 4, 52 }, { 4, 57 },
+  { 49, 4 }, { 45, 1 }, { 39, 0 }, { 33, 0 }, { 27, 0 }, { 21, 1 }, { 17, 4 }, { 12, 8 },
+  { 9, 12 }, { 6, 17 }, { 4, 23 }, { 3, 30 }, { 3, 37 }, { 3, 46 }, { 3, 53 }, { 13, 52 },
+  { 13, 46 }, { 13, 38 }, { 13, 31 }, { 14, 26 }, { 16, 21 }, { 18, 17 }, { 20, 14 }, { 22, 12 },
+  { 25, 10 }, { 29, 9 }, { 33, 9 }, { 37, 9 }, { 41, 10 }, { 44, 12 },
+  // 7
+  { 2, 9 }, { 57, 9 }, { 57, 0 }, { 2, 0 },
+  { 44, 6 }, { 18, 57 }, { 20, 84 }, { 30, 84 }, { 30, 59 }, { 53, 10 },
+  // 8
+  { 43, 22 }, { 43, 25 }, { 42, 27 }, { 41, 30 }, { 40, 32 }, { 38, 33 }, { 36, 35 }, { 34, 36 },
+  { 32, 36 }, { 30, 36 }, { 27, 36 }, { 25, 36 }, { 23, 35 }, { 21, 33 }, { 19, 32 }, { 18, 30 },
+  { 17, 27 }, { 16, 25 }, { 16, 23 }, { 6, 23 }, { 6, 27 }, { 7, 31 }, { 9, 34 }, { 11, 38 },
+  { 14, 41 }, { 18, 43 }, { 21, 45 }, { 25, 46 }, { 30, 47 }, { 34, 46 }, { 38, 45 }, { 41, 43 },
+  { 45, 41 }, { 48, 38 }, { 50, 34 }, { 52, 31 }, { 53, 27 }, { 53, 22 },
+  { 16, 23 }, { 16, 20 }, { 17, 18 }, { 18, 15 }, { 19, 13 }, { 21, 12 }, { 23, 10 }, { 25, 9 },
+  { 27, 9 }, { 29, 9 }, { 32, 9 }, { 34, 9 }, { 36, 10 }, { 38, 12 }, { 40, 13 }, { 41, 15 },
+  { 42, 18 }, { 43, 20 }, { 43, 22 }, { 53, 22 }, { 53, 18 }, { 52, 14 }, { 50, 11 }, { 48, 7 },
+  { 45, 4 }, { 41, 2 }, { 38, 0 }, { 34, 0 }, { 29, 0 }, { 25, 0 }, { 21, 0 }, { 18, 2 },
+  { 14, 4 }, { 11, 7 }, { 9, 11 }, { 7, 14 }, { 6, 18 }, { 6, 23 },
+  { 45, 60 }, { 45, 63 }, { 45, 66 }, { 43, 68 }, { 42, 70 }, { 40, 72 }, { 38, 73 }, { 35, 75 },
+  { 32, 75 }, { 30, 75 }, { 27, 75 }, { 24, 75 }, { 21, 73 }, { 19, 72 }, { 17, 70 }, { 16, 68 },
+  { 14, 66 }, { 14, 63 }, { 14, 60 }, { 3, 60 }, { 4, 65 }, { 5, 69 }, { 7, 73 }, { 10, 77 },
+  { 13, 80 }, { 17, 82 }, { 21, 84 }, { 25, 84 }, { 30, 84 }, { 34, 84 }, { 38, 84 }, { 42, 82 },
+  { 46, 80 }, { 49, 77 }, { 52, 73 }, { 54, 69 }, { 55, 65 }, { 56, 60 },
+  { 14, 60 }, { 14, 58 }, { 14, 55 }, { 16, 53 }, { 17, 51 }, { 19, 49 }, { 21, 48 }, { 24, 46 },
+  { 27, 46 }, { 30, 46 }, { 32, 46 }, { 35, 46 }, { 38, 48 }, { 40, 49 }, { 42, 51 }, { 43, 53 },
+  { 45, 55 }, { 45, 58 }, { 45, 60 }, { 56, 60 }, { 55, 56 }, { 54, 52 }, { 52, 48 }, { 49, 44 },
+  { 46, 41 }, { 42, 39 }, { 38, 37 }, { 34, 36 }, { 29, 35 }, { 25, 36 }, { 21, 37 }, { 17, 39 },
+  { 13, 41 }, { 10, 44 }, { 7, 48 }, { 5, 52 }, { 4, 56 }, { 3, 60 },
+  // 9
+  { 44, 28 }, { 44, 31 }, { 44, 35 }, { 42, 38 }, { 41, 40 }, { 39, 42 }, { 37, 44 }, { 35, 45 },
+  { 32, 46 }, { 29, 46 }, { 26, 46 }, { 23, 45 }, { 21, 44 }, { 19, 42 }, { 17, 40 }, { 16, 38 },
+  { 14, 35 }, { 14, 31 }, { 14, 28 }, { 3, 28 }, { 4, 33 }, { 5, 38 }, { 7, 42 }, { 9, 46 },
+  { 12, 49 }, { 16, 52 }, { 20, 54 }, { 24, 56 }, { 29, 56 }, { 34, 56 }, { 38, 54 }, { 42, 52 },
+  { 46, 49 }, { 49, 46 }, { 51, 42 }, { 53, 38 }, { 54, 33 }, { 55, 28 },
+  { 14, 28 }, { 14, 24 }, { 14, 20 }, { 16, 17 }, { 17, 15 }, { 19, 13 }, { 21, 11 }, { 23, 10 },
+  { 26, 9 }, { 29, 9 }, { 32, 9 }, { 35, 10 }, { 37, 11 }, { 39, 13 }, { 41, 15 }, { 42, 17 },
+  { 44, 20 }, { 44, 24 }, { 44, 28 }, { 55, 28 }, { 54, 22 }, { 53, 17 }, { 51, 13 }, { 49, 9 },
+  { 46, 6 }, { 42, 3 }, { 38, 1 }, { 34, 0 }, { 29, 0 }, { 24, 0 }, { 20, 1 }, { 16, 3 },
+  { 12, 6 }, { 9, 9 }, { 7, 13 }, { 5, 17 }, { 4, 22 }, { 3, 28 },
+  { 45, 22 }, { 45, 57 }, { 45, 60 }, { 44, 63 }, { 42, 65 }, { 40, 68 }, { 38, 71 }, { 35, 73 },
+  { 32, 74 }, { 29, 75 }, { 25, 75 }, { 23, 75 }, { 19, 75 }, { 16, 73 }, { 13, 71 }, { 8, 80 },
+  { 12, 82 }, { 16, 84 }, { 21, 84 }, { 26, 84 }, { 31, 84 }, { 35, 83 }, { 40, 81 }, { 44, 78 },
+  { 48, 75 }, { 51, 71 }, { 53, 66 }, { 55, 62 }, { 55, 57 }, { 55, 22 },
+};
+
+static const DigitPath _digitPaths[26] = {
+  { 0, 38 },
+  { 38, 38 },
+  { 76, 4 },
+  { 80, 4 },
+  { 84, 46 },
+  { 130, 4 },
+  { 134, 58 },
+  { 192, 54 },
+  { 246, 4 },
+  { 250, 4 },
+  { 254, 4 },
+  { 258, 4 },
+  { 262, 4 },
+  { 266, 56 },
+  { 322, 38 },
+  { 360, 38 },
+  { 398, 30 },
+  { 428, 4 },
+  { 432, 6 },
+  { 438, 38 },
+  { 476, 38 },
+  { 514, 38 },
+  { 552, 38 },
+  { 590, 38 },
+  { 628, 38 },
+  { 666, 30 },
+};
+
+#define DIGIT_PATH_MAX_POINTS 58
+static const uint8_t _digitFirstPath[11] = { 0, 2, 4, 6, 8, 11, 14, 17, 19, 23, 26 };
+// END GENERATED
+
+static GPoint scalePoint(int8_t x, int8_t y, GSize size);
+
+void DrawVectorDigit(GContext* ctx, uint16_t digit, GRect frame) {
+  GPoint points[DIGIT_PATH_MAX_POINTS];
+
+  // GPath is only borrowed for the fill, so it can live on the stack rather
+  // than going through gpath_create.
+  GPath path = {
+    .num_points = 0,
+    .points = points,
+    .rotation = 0,
+    .offset = frame.origin
+  };
+
+  graphics_context_set_fill_color(ctx, GColorBlack);
+
+  for (uint16_t index = _digitFirstPath[digit]; index < _digitFirstPath[digit + 1]; index++) {
+    const DigitPoint* point = &_digitPoints[_digitPaths[index].firstPoint];
+
+    for (uint8_t i = 0; i < _digitPaths[index].pointCount; i++, point++) {
+      points[i] = scalePoint(point->x, point->y, frame.size);
+    }
+
+    path.num_points = _digitPaths[index].pointCount;
+    gpath_draw_filled(ctx, &path);
+  }
+}
+
+static GPoint scalePoint(int8_t x, int8_t y, GSize size) {
+  return GPoint(x * size.w / VECTOR_DIGIT_WIDTH, y * size.h / VECTOR_DIGIT_HEIGHT);
+}
+#endif
\ No newline at end of file
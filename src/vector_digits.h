@@ -0,0 +1,9 @@
+#pragma once
+#include "common.h"
+
+// Size of the design space the digit geometry is stored in, which matches the
+// 59x84 digit bitmaps.
+#define VECTOR_DIGIT_WIDTH 59
+#define VECTOR_DIGIT_HEIGHT 84
+
+void DrawVectorDigit(GContext* ctx, uint16_t digit, GRect frame);
\ No newline at end of file
@@ -1,22 +1,50 @@
 #include <pebble.h>
 #include "water_layer.h"
+#include "trace_recorder.h"
 
+#ifdef SMOOTH_FILL
+#define MS_PER_HOUR 3600000
+
+// Convert from milliseconds into the hour to water height, matching WATER_TOP.
+#define WATER_HEIGHT_MS(ms) ((ms) * 14 / 300000)
+#endif
+
+#ifdef SMOOTH_FILL
+static void drawSmoothWater(WaterLayerData* data, int32_t msIntoHour);
+#ifndef RUN_TEST
+static void smoothTimerCallback(void *callback_data);
+#endif
+#else
 static PropertyAnimation* _animation = NULL;
 
 static void animationStoppedHandler(Animation *animation, bool finished, void *context);
+#endif
 
 WaterLayerData* CreateWaterLayer(Layer* relativeLayer, LayerRelation relation) {
-  WaterLayerData* data = malloc(sizeof(WaterLayerData));
+  WaterLayerData* data = ArenaAlloc(sizeof(WaterLayerData));
   if (data != NULL) {
     data->inverterLayer = inverter_layer_create(GRect(0, 0, 0, 0));
     AddLayer(relativeLayer, (Layer*) data->inverterLayer, relation);
     data->lastUpdateMinute = -1;
+#ifdef SMOOTH_FILL
+    data->smoothHeight = -1;
+#endif
   }
   
   return data;
 }
 
-void DrawWaterLayer(WaterLayerData* data, uint16_t hour, uint16_t minute) {
+void DrawWaterLayer(WaterLayerData* data, uint16_t hour, uint16_t minute, uint16_t second) {
+#ifdef SMOOTH_FILL
+  // The smooth fill timer follows the clock itself. The tick resyncs it to
+  // the time the rest of the face is drawn with, in case the time was changed.
+  if (data->smoothTimer != NULL) {
+    app_timer_cancel(data->smoothTimer);
+    data->smoothTimer = NULL;
+  }
+  
+  drawSmoothWater(data, ((minute * 60) + second) * 1000);
+#else
   // Exit if this minute has already been handled.
   if (data->lastUpdateMinute == minute) {
     return;
@@ -41,21 +69,84 @@ void DrawWaterLayer(WaterLayerData* data, uint16_t hour, uint16_t minute) {
     }, NULL);
 
     animation_schedule((Animation*) _animation);
+    TraceEvent(TRACE_ANIMATION_START, minute);
+  }
+#endif
+}
+
+// Stop any pending animation or timer. The next draw jumps straight to the
+// current level as on first display.
+void SuspendWaterLayer(WaterLayerData* data) {
+#ifdef SMOOTH_FILL
+  if (data->smoothTimer != NULL) {
+    app_timer_cancel(data->smoothTimer);
+    data->smoothTimer = NULL;
+  }
+  
+  data->smoothHeight = -1;
+#else
+  if (_animation != NULL) {
+    animation_unschedule((Animation*) _animation);
   }
+#endif
+  
+  data->lastUpdateMinute = -1;
 }
 
 void DestroyWaterLayer(WaterLayerData* data) {
   if (data != NULL) {
+#ifdef SMOOTH_FILL
+    if (data->smoothTimer != NULL) {
+      app_timer_cancel(data->smoothTimer);
+      data->smoothTimer = NULL;
+    }
+#endif
+    
     if (data->inverterLayer != NULL) {
       inverter_layer_destroy(data->inverterLayer);
       data->inverterLayer = NULL;
     }
-    
-    free(data);
   }
 }
 
+#ifndef SMOOTH_FILL
 static void animationStoppedHandler(Animation *animation, bool finished, void *context) {
+  TraceEvent(TRACE_ANIMATION_STOP, finished);
   property_animation_destroy(_animation);
   _animation = NULL;
-}
\ No newline at end of file
+}
+#else
+static void drawSmoothWater(WaterLayerData* data, int32_t msIntoHour) {
+  int16_t height = WATER_HEIGHT_MS(msIntoHour);
+  
+  if (height != data->smoothHeight) {
+    layer_set_frame((Layer*) data->inverterLayer, GRect(0, SCREEN_HEIGHT - height, SCREEN_WIDTH, height));
+    data->smoothHeight = height;
+  }
+  
+#ifndef RUN_TEST
+  // Wake up again only when the water reaches the next pixel row (about every 21 seconds).
+  // Test builds step a fake clock on each tick instead, so they only draw from DrawWaterLayer.
+  int32_t nextMs = ((height + 1) * 300000 + 13) / 14;
+  if (nextMs > MS_PER_HOUR) {
+    nextMs = MS_PER_HOUR;
+  }
+  
+  data->smoothTimer = app_timer_register(nextMs - msIntoHour, smoothTimerCallback, data);
+#endif
+}
+
+#ifndef RUN_TEST
+static void smoothTimerCallback(void *callback_data) {
+  WaterLayerData* data = (WaterLayerData*) callback_data;
+  data->smoothTimer = NULL;
+  
+  time_t now;
+  uint16_t ms;
+  time_ms(&now, &ms);
+  
+  struct tm* localNow = localtime(&now);
+  drawSmoothWater(data, ((localNow->tm_min * 60) + localNow->tm_sec) * 1000 + ms);
+}
+#endif
+#endif
\ No newline at end of file
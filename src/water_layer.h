@@ -4,8 +4,13 @@
 typedef struct {
   InverterLayer* inverterLayer;
   int16_t lastUpdateMinute;
+#ifdef SMOOTH_FILL
+  int16_t smoothHeight;
+  AppTimer* smoothTimer;
+#endif
 } WaterLayerData;
 
 WaterLayerData* CreateWaterLayer(Layer* relativeLayer, LayerRelation relation);
-void DrawWaterLayer(WaterLayerData* data, uint16_t hour, uint16_t minute);
+void DrawWaterLayer(WaterLayerData* data, uint16_t hour, uint16_t minute, uint16_t second);
+void SuspendWaterLayer(WaterLayerData* data);
 void DestroyWaterLayer(WaterLayerData* data);
\ No newline at end of file
@@ -0,0 +1,359 @@
+// Benchmark for the settings round trip between pebble-js-app.js and the
+// watchface, over a simulated AppMessage link.
+//
+//   node tools/companion_bench.js [--latency=ms] [--jitter=ms] [--drop=rate]
+//                                 [--timeout=ms] [--trials=n] [--seed=n] [--clock24=0|1]
+//
+// pebble-js-app.js runs unmodified with stubbed Pebble and localStorage
+// objects. The watch side is main.c itself: each trial runs its AppMessage
+// handlers (inbox_received_callback, sendSetupInfo, outbox callbacks) in
+// build/host/companion_bridge, built here with make -C tools/host against
+// the host pebble.h. Time is simulated on both sides, so results depend
+// only on the arguments.
+//
+// Reported per trial:
+//   time-to-config-page     showConfiguration until Pebble.openURL
+//   time-to-settings-applied  webviewclosed until the watch persists settings
+
+var childProcess = require("child_process");
+var fs = require("fs");
+var path = require("path");
+var readline = require("readline");
+var vm = require("vm");
+
+var ROOT = path.join(__dirname, "..");
+var APP_KEYS = JSON.parse(fs.readFileSync(path.join(ROOT, "appinfo.json"), "utf8")).appKeys;
+var JS_SOURCE = fs.readFileSync(path.join(ROOT, "src", "pebble-js-app.js"), "utf8");
+var BRIDGE = path.join(ROOT, "build", "host", "companion_bridge");
+
+// Watch time at the start of each trial.
+var WATCH_EPOCH = Date.UTC(2015, 0, 1, 10, 0, 0);
+
+// AppMessageResult reported to the watch for a message that was not acked.
+var APP_MSG_SEND_TIMEOUT = 2;
+
+var SETTINGS_KEYS = ["KEY_CURRENT_VERSION", "KEY_HOUR_VIBRATE", "KEY_HOUR_VIBRATE_START",
+                     "KEY_HOUR_VIBRATE_END", "KEY_BLUETOOTH_VIBRATE"];
+
+var KEY_NAMES = {};
+Object.keys(APP_KEYS).forEach(function(name) {
+  KEY_NAMES[APP_KEYS[name]] = name;
+});
+
+var options = parseArguments(process.argv.slice(2), {
+  latency: 50,
+  jitter: 20,
+  drop: 0,
+  timeout: 1000,
+  trials: 1000,
+  seed: 1,
+  clock24: 0
+});
+
+// Simulated clock and event queue.
+function Simulation(seed) {
+  this.now = 0;
+  this.queue = [];
+  this.sequence = 0;
+  this.random = createRandom(seed);
+}
+
+Simulation.prototype.schedule = function(delay, callback) {
+  this.queue.push({ time: this.now + delay, sequence: this.sequence++, callback: callback });
+};
+
+// Events that talk to the watch return a promise, which is waited on before
+// the next event runs.
+Simulation.prototype.run = function() {
+  var simulation = this;
+  if (this.queue.length === 0) {
+    return Promise.resolve();
+  }
+
+  this.queue.sort(function(a, b) {
+    return (a.time - b.time) || (a.sequence - b.sequence);
+  });
+
+  var event = this.queue.shift();
+  this.now = event.time;
+  return Promise.resolve(event.callback()).then(function() {
+    return simulation.run();
+  });
+};
+
+// One direction of an AppMessage link. A message or its ack can be lost; the
+// sender then gets a nack after the timeout, as with a real phone connection.
+function Link(simulation) {
+  this.simulation = simulation;
+}
+
+Link.prototype.delay = function() {
+  return Math.max(0, options.latency + ((this.simulation.random() * 2) - 1) * options.jitter);
+};
+
+Link.prototype.send = function(dictionary, receive, ack, nack) {
+  var simulation = this.simulation;
+  var link = this;
+  var lost = simulation.random() < options.drop;
+  var ackLost = simulation.random() < options.drop;
+
+  if (lost) {
+    simulation.schedule(options.timeout, nack);
+    return;
+  }
+
+  simulation.schedule(this.delay(), function() {
+    return Promise.resolve(receive(dictionary)).then(function() {
+      simulation.schedule(ackLost ? Math.max(0, options.timeout - link.delay()) : link.delay(), ackLost ? nack : ack);
+    });
+  });
+};
+
+// The watchface, running in companion_bridge. Commands go out stamped with the
+// simulated time; the bridge answers with what the face did, then "done".
+function Watch(simulation, link) {
+  var watch = this;
+  this.simulation = simulation;
+  this.link = link;
+  this.settingsApplied = null;
+  this.phone = null;
+  this.lines = [];
+  this.pending = null;
+
+  var args = ["--time", String(WATCH_EPOCH)].concat(options.clock24 ? ["--24h"] : []);
+  this.process = childProcess.spawn(BRIDGE, args, { stdio: ["pipe", "pipe", "inherit"] });
+  this.exited = new Promise(function(resolve) {
+    watch.process.on("close", resolve);
+  });
+
+  readline.createInterface({ input: this.process.stdout }).on("line", function(line) {
+    if (line !== "done") {
+      watch.lines.push(line);
+      return;
+    }
+
+    var lines = watch.lines;
+    var pending = watch.pending;
+    watch.lines = [];
+    watch.pending = null;
+    pending(lines);
+  });
+
+  this.ready = this.reply();
+}
+
+Watch.prototype.reply = function() {
+  var watch = this;
+  return new Promise(function(resolve) {
+    watch.pending = resolve;
+  });
+};
+
+Watch.prototype.command = function(text) {
+  var watch = this;
+  var reply = this.reply();
+  this.process.stdin.write(Math.round(WATCH_EPOCH + this.simulation.now) + " " + text + "\n");
+
+  return reply.then(function(lines) {
+    lines.forEach(function(line) {
+      watch.handle(line.split(" "));
+    });
+  });
+};
+
+Watch.prototype.handle = function(words) {
+  var watch = this;
+
+  if (words[0] === "outbox") {
+    var payload = {};
+    words.slice(1).forEach(function(pair) {
+      var parts = pair.split("=");
+      if (!KEY_NAMES.hasOwnProperty(parts[0])) {
+        throw new Error("Key " + parts[0] + " is not in appinfo.json appKeys");
+      }
+
+      payload[KEY_NAMES[parts[0]]] = parseInt(parts[1]);
+    });
+
+    this.link.send(payload,
+                   function(payload) { watch.phone.receive(payload); },
+                   function() { return watch.command("sent"); },
+                   function() { return watch.command("failed " + APP_MSG_SEND_TIMEOUT); });
+
+  } else if (words[0] === "persist" && SETTINGS_KEYS.indexOf(KEY_NAMES[words[1]]) >= 0) {
+    if (this.settingsApplied === null) {
+      this.settingsApplied = this.simulation.now;
+    }
+  }
+};
+
+Watch.prototype.receive = function(dictionary) {
+  return this.command("inbox " + Object.keys(dictionary).map(function(key) {
+    return APP_KEYS[key] + "=" + dictionary[key];
+  }).join(" "));
+};
+
+Watch.prototype.quit = function() {
+  this.command("quit");
+  this.process.stdin.end();
+  return this.exited;
+};
+
+// pebble-js-app.js running in its own context with stubbed globals.
+function Phone(simulation, link) {
+  var phone = this;
+  this.simulation = simulation;
+  this.link = link;
+  this.listeners = {};
+  this.configPageOpened = null;
+  this.watch = null;
+
+  var storage = this.storage = {};
+  var context = {
+    console: { log: function() {} },
+    localStorage: {
+      getItem: function(name) { return storage.hasOwnProperty(name) ? storage[name] : null; },
+      setItem: function(name, value) { storage[name] = String(value); }
+    },
+    Pebble: {
+      addEventListener: function(name, callback) { phone.listeners[name] = callback; },
+      openURL: function(url) {
+        if (phone.configPageOpened === null) {
+          phone.configPageOpened = simulation.now;
+        }
+      },
+      sendAppMessage: function(dictionary, ack, nack) {
+        checkKeys(dictionary);
+        phone.link.send(dictionary,
+                        function(payload) { return phone.watch.receive(payload); },
+                        function() { ack({}); },
+                        function() { nack({ error: { message: "timeout" } }); });
+      }
+    }
+  };
+
+  vm.runInNewContext(JS_SOURCE, context, { filename: "pebble-js-app.js" });
+}
+
+Phone.prototype.receive = function(payload) {
+  checkKeys(payload);
+  this.emit("appmessage", { payload: payload });
+};
+
+Phone.prototype.emit = function(name, event) {
+  if (this.listeners[name]) {
+    this.listeners[name](event);
+  }
+};
+
+function runTrial(seed) {
+  var simulation = new Simulation(seed);
+  var link = new Link(simulation);
+  var phone = new Phone(simulation, link);
+  var watch = new Watch(simulation, link);
+  var configStart = null;
+  var settingsStart = null;
+  phone.watch = watch;
+  watch.phone = phone;
+
+  phone.emit("ready", {});
+  return watch.ready.then(function() {
+    return simulation.run();
+
+  }).then(function() {
+    configStart = simulation.now;
+    phone.emit("showConfiguration", {});
+    return simulation.run();
+
+  }).then(function() {
+    // The configuration page returns the installed version the watch reported.
+    var response = {
+      currentVersion: parseInt(phone.storage.installedVersion) || 0,
+      hourVibrate: 1, hourVibrateStart: 9, hourVibrateEnd: 18, bluetoothVibrate: 1
+    };
+    settingsStart = simulation.now;
+    phone.emit("webviewclosed", { response: encodeURIComponent(JSON.stringify(response)) });
+    return simulation.run();
+
+  }).then(function() {
+    return watch.quit();
+
+  }).then(function() {
+    return {
+      config: (phone.configPageOpened === null) ? null : (phone.configPageOpened - configStart),
+      settings: (watch.settingsApplied === null) ? null : (watch.settingsApplied - settingsStart)
+    };
+  });
+}
+
+function summarize(name, values) {
+  var done = values.filter(function(value) { return value !== null; }).sort(function(a, b) { return a - b; });
+  var percentile = function(p) {
+    return done.length ? done[Math.min(done.length - 1, Math.floor(p * done.length))].toFixed(1) : "-";
+  };
+
+  console.log(pad(name, 26) + pad(percentile(0.5), 10) + pad(percentile(0.95), 10) +
+              pad(done.length ? done[done.length - 1].toFixed(1) : "-", 10) +
+              ((100 * done.length / values.length).toFixed(1) + "%"));
+}
+
+function checkKeys(dictionary) {
+  Object.keys(dictionary).forEach(function(key) {
+    if (!APP_KEYS.hasOwnProperty(key)) {
+      throw new Error("Key " + key + " is not in appinfo.json appKeys");
+    }
+  });
+}
+
+// Deterministic PRNG (mulberry32) so runs are repeatable.
+function createRandom(seed) {
+  var state = seed >>> 0;
+  return function() {
+    state = (state + 0x6D2B79F5) >>> 0;
+    var t = state;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+function parseArguments(args, defaults) {
+  args.forEach(function(arg) {
+    var match = /^--([a-z0-9]+)=(.*)$/.exec(arg);
+    if (!match || !defaults.hasOwnProperty(match[1])) {
+      throw new Error("Unknown argument " + arg);
+    }
+
+    defaults[match[1]] = parseFloat(match[2]);
+  });
+
+  return defaults;
+}
+
+function pad(text, width) {
+  text = String(text);
+  return text + new Array(Math.max(1, width - text.length + 1)).join(" ");
+}
+
+function runTrials(trial, configTimes, settingsTimes) {
+  if (trial === options.trials) {
+    console.log("latency " + options.latency + "ms, jitter " + options.jitter + "ms, drop " +
+                options.drop + ", timeout " + options.timeout + "ms, " + options.trials + " trials");
+    console.log(pad("", 26) + pad("p50 ms", 10) + pad("p95 ms", 10) + pad("max ms", 10) + "completed");
+    summarize("time-to-config-page", configTimes);
+    summarize("time-to-settings-applied", settingsTimes);
+    return;
+  }
+
+  return runTrial(options.seed + trial).then(function(result) {
+    configTimes.push(result.config);
+    settingsTimes.push(result.settings);
+    return runTrials(trial + 1, configTimes, settingsTimes);
+  });
+}
+
+childProcess.execFileSync("make", ["-s", "-C", path.join(ROOT, "tools", "host"), "companion_bridge"], { stdio: "inherit" });
+runTrials(0, [], []).catch(function(error) {
+  console.error(error);
+  process.exitCode = 1;
+});
\ No newline at end of file
@@ -0,0 +1,148 @@
+// Runs the watchface's AppMessage handlers for tools/companion_bench.js.
+//
+//   build/host/companion_bridge [--time MS] [--24h] [--verbose]
+//
+// One process is one run of main.c (with the real trace recorder), started
+// at watch time MS in milliseconds since the epoch. Commands arrive on stdin,
+// one per line, each starting with the watch time; timers due by then run
+// first:
+//
+//   <ms> inbox <key>=<int> ...    deliver a message from the phone
+//   <ms> sent                     ack the message in the outbox
+//   <ms> failed <reason>          nack it with an AppMessageResult
+//   <ms> quit                     leave the event loop and run deinit
+//
+// Each command is answered with what the face did, then "done":
+//
+//   outbox <key>=<int> ...        the face handed a message to the outbox
+//   persist <key>                 the face wrote a persisted value
+//
+// A "done" also follows init, before the first command is read.
+#include <stdio.h>
+#include <pebble.h>
+#include "host_sdk.h"
+
+#define LINE_SIZE 512
+
+int FillerupMain(void);
+
+static void printOutbox(DictionaryIterator *iter) {
+  printf("outbox");
+  for (Tuple *tuple = dict_read_first(iter); tuple != NULL; tuple = dict_read_next(iter)) {
+    switch (tuple->type) {
+      case TUPLE_INT:
+        printf(" %u=%d", (unsigned) tuple->key, (tuple->length == 4) ? (int) tuple->value->int32 :
+               (tuple->length == 2) ? (int) tuple->value->int16 : (int) tuple->value->int8);
+        break;
+
+      case TUPLE_UINT:
+        printf(" %u=%u", (unsigned) tuple->key, (tuple->length == 4) ? (unsigned) tuple->value->uint32 :
+               (tuple->length == 2) ? (unsigned) tuple->value->uint16 : (unsigned) tuple->value->uint8);
+        break;
+
+      default:
+        // Only integers are exchanged with the companion.
+        printf(" %u=0", (unsigned) tuple->key);
+        break;
+    }
+  }
+
+  printf("\n");
+}
+
+static void printPersist(uint32_t key) {
+  printf("persist %u\n", (unsigned) key);
+}
+
+static bool deliverInbox(char *arguments) {
+  uint8_t buffer[256];
+  DictionaryIterator iter;
+  dict_write_begin(&iter, buffer, app_message_inbox_size_maximum());
+
+  for (char *pair = strtok(arguments, " \n"); pair != NULL; pair = strtok(NULL, " \n")) {
+    unsigned key;
+    int value;
+    if (sscanf(pair, "%u=%d", &key, &value) != 2 || dict_write_int32(&iter, key, value) != DICT_OK) {
+      return false;
+    }
+  }
+
+  dict_write_end(&iter);
+  HostInbox(&iter);
+  return true;
+}
+
+static void eventLoop(void) {
+  char line[LINE_SIZE];
+
+  printf("done\n");
+  fflush(stdout);
+
+  while (fgets(line, sizeof(line), stdin) != NULL) {
+    long long ms;
+    char command[16];
+    int consumed = 0;
+
+    if (sscanf(line, "%lld %15s %n", &ms, command, &consumed) < 2) {
+      fprintf(stderr, "companion_bridge: bad command: %s", line);
+      exit(2);
+    }
+
+    HostAdvanceTo(ms);
+
+    bool ok = true;
+    if (strcmp(command, "inbox") == 0) {
+      ok = deliverInbox(line + consumed);
+
+    } else if (strcmp(command, "sent") == 0) {
+      HostOutboxComplete(true, APP_MSG_OK);
+
+    } else if (strcmp(command, "failed") == 0) {
+      HostOutboxComplete(false, atoi(line + consumed));
+
+    } else if (strcmp(command, "quit") == 0) {
+      return;
+
+    } else {
+      ok = false;
+    }
+
+    if (ok == false) {
+      fprintf(stderr, "companion_bridge: bad command: %s", line);
+      exit(2);
+    }
+
+    printf("done\n");
+    fflush(stdout);
+  }
+}
+
+int main(int argc, char **argv) {
+  HostSetLogFile(NULL);
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+      HostSetTime(atoll(argv[++i]));
+
+    } else if (strcmp(argv[i], "--24h") == 0) {
+      HostSet24HourStyle(true);
+
+    } else if (strcmp(argv[i], "--verbose") == 0) {
+      HostSetLogFile(stderr);
+
+    } else {
+      fprintf(stderr, "usage: %s [--time MS] [--24h] [--verbose]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  HostSetOutboxHandler(printOutbox);
+  HostSetPersistHandler(printPersist);
+  HostSetEventLoop(eventLoop);
+
+  FillerupMain();
+
+  printf("done\n");
+  fflush(stdout);
+  return 0;
+}
\ No newline at end of file
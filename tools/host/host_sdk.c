@@ -0,0 +1,1263 @@
+#include <stdio.h>
+#include <pebble.h>
+#include "host_sdk.h"
+
+// aplite AppMessage buffer limits.
+#define INBOX_SIZE_MAXIMUM 124
+#define OUTBOX_SIZE_MAXIMUM 636
+
+// Animations step at roughly the display's 30 frames per second.
+#define ANIMATION_FRAME_MS 33
+
+// Heap left to the face once its code, stack and windows are loaded. Only
+// bitmaps are charged against it, which is what the hour prefetch checks.
+#define HEAP_FREE 16384
+
+#define PERSIST_SLOTS 64
+#define TIMER_SLOTS 32
+#define TUPLE_HEADER_SIZE (sizeof(Tuple))
+
+typedef enum { OUTBOX_IDLE, OUTBOX_WRITING, OUTBOX_SENDING } OutboxState;
+
+typedef struct {
+  uint32_t id;
+  int64_t dueMs;
+  AppTimerCallback callback;
+  void *data;
+} HostTimer;
+
+typedef struct {
+  bool used;
+  uint32_t key;
+  uint16_t size;
+  uint8_t data[PERSIST_DATA_MAX_LENGTH];
+} PersistSlot;
+
+struct Window {
+  Layer root;
+  WindowHandlers handlers;
+  GColor backgroundColor;
+  bool loaded;
+};
+
+struct GContext {
+  GColor fillColor;
+  GCompOp compositingMode;
+};
+
+static const char *_resourceFiles[] = HOST_RESOURCE_FILES;
+
+static int64_t _nowMs = 0;
+static struct tm _localTime;
+static HostStats _stats;
+static FILE *_logFile = NULL;
+static bool _logFileSet = false;
+static void (*_eventLoop)(void) = NULL;
+
+static Window *_topWindow = NULL;
+static bool _dirty = false;
+static size_t _bitmapBytes = 0;
+
+static HostTimer _timers[TIMER_SLOTS];
+static uint32_t _nextTimerId = 1;
+static Animation *_animations = NULL;
+
+static TickHandler _tickHandler = NULL;
+static BluetoothConnectionHandler _bluetoothHandler = NULL;
+static BatteryStateHandler _batteryHandler = NULL;
+static AppFocusHandler _focusHandler = NULL;
+static bool _connected = true;
+static BatteryChargeState _battery = { .charge_percent = 100 };
+static bool _clock24Hour = false;
+
+static bool _messageOpen = false;
+static uint32_t _inboxSize = 0;
+static uint32_t _outboxSize = 0;
+static void *_messageContext = NULL;
+static AppMessageInboxReceived _inboxReceived = NULL;
+static AppMessageInboxDropped _inboxDropped = NULL;
+static AppMessageOutboxSent _outboxSent = NULL;
+static AppMessageOutboxFailed _outboxFailed = NULL;
+static void (*_outboxHandler)(DictionaryIterator *iter) = NULL;
+static OutboxState _outboxState = OUTBOX_IDLE;
+static uint8_t _outboxBuffer[OUTBOX_SIZE_MAXIMUM];
+static uint8_t _outboxDone[OUTBOX_SIZE_MAXIMUM];
+static uint8_t _inboxBuffer[INBOX_SIZE_MAXIMUM];
+static DictionaryIterator _outboxIter;
+
+static PersistSlot _persist[PERSIST_SLOTS];
+static void (*_persistHandler)(uint32_t key) = NULL;
+
+static void render();
+static void drawLayer(Layer *layer, GContext *ctx);
+static void stepAnimation(Animation *animation);
+static void removeAnimation(Animation *animation);
+static PersistSlot* findPersist(uint32_t key);
+static PersistSlot* writePersist(uint32_t key, const void *data, size_t size);
+static void readPngSize(uint32_t resourceId, GSize *size);
+
+// Clock
+
+void HostSetTime(int64_t ms) {
+  _nowMs = ms;
+}
+
+int64_t HostNowMs() {
+  return _nowMs;
+}
+
+time_t HostTime(time_t *t) {
+  time_t now = (time_t) (_nowMs / 1000);
+  if (t != NULL) {
+    *t = now;
+  }
+
+  return now;
+}
+
+struct tm* HostLocaltime(const time_t *t) {
+  gmtime_r(t, &_localTime);
+  return &_localTime;
+}
+
+uint16_t time_ms(time_t *t_utc, uint16_t *out_ms) {
+  uint16_t ms = (uint16_t) (_nowMs % 1000);
+  HostTime(t_utc);
+  if (out_ms != NULL) {
+    *out_ms = ms;
+  }
+
+  return ms;
+}
+
+int64_t HostNextDue() {
+  int64_t due = -1;
+
+  for (uint16_t i = 0; i < TIMER_SLOTS; i++) {
+    if (_timers[i].id != 0 && (due < 0 || _timers[i].dueMs < due)) {
+      due = _timers[i].dueMs;
+    }
+  }
+
+  for (Animation *animation = _animations; animation != NULL; animation = animation->next) {
+    if (due < 0 || animation->frame_ms < due) {
+      due = animation->frame_ms;
+    }
+  }
+
+  return due;
+}
+
+void HostAdvanceTo(int64_t ms) {
+  render();
+
+  for (int64_t due = HostNextDue(); due >= 0 && due <= ms; due = HostNextDue()) {
+    if (due > _nowMs) {
+      _nowMs = due;
+    }
+
+    // Timers first, oldest registration first among equals.
+    HostTimer *timer = NULL;
+    for (uint16_t i = 0; i < TIMER_SLOTS; i++) {
+      if (_timers[i].id != 0 && _timers[i].dueMs <= _nowMs && (timer == NULL || _timers[i].id < timer->id)) {
+        timer = &_timers[i];
+      }
+    }
+
+    if (timer != NULL) {
+      HostTimer fired = *timer;
+      timer->id = 0;
+      _stats.timersFired++;
+      fired.callback(fired.data);
+
+    } else {
+      for (Animation *animation = _animations; animation != NULL; animation = animation->next) {
+        if (animation->frame_ms <= _nowMs) {
+          stepAnimation(animation);
+          break;
+        }
+      }
+    }
+
+    render();
+  }
+
+  if (ms > _nowMs) {
+    _nowMs = ms;
+  }
+}
+
+// Driver events
+
+bool HostTick(TimeUnits unitsChanged) {
+  if (_tickHandler == NULL) {
+    return false;
+  }
+
+  time_t now = HostTime(NULL);
+  _tickHandler(HostLocaltime(&now), unitsChanged);
+  render();
+  return true;
+}
+
+bool HostBluetooth(bool connected) {
+  _connected = connected;
+
+  if (_bluetoothHandler == NULL) {
+    return false;
+  }
+
+  _bluetoothHandler(connected);
+  render();
+  return true;
+}
+
+bool HostBattery(BatteryChargeState state) {
+  _battery = state;
+
+  if (_batteryHandler == NULL) {
+    return false;
+  }
+
+  _batteryHandler(state);
+  render();
+  return true;
+}
+
+bool HostFocus(bool inFocus) {
+  if (_focusHandler == NULL) {
+    return false;
+  }
+
+  _focusHandler(inFocus);
+  render();
+  return true;
+}
+
+bool HostInbox(DictionaryIterator *iter) {
+  if (_messageOpen == false || _inboxReceived == NULL) {
+    return false;
+  }
+
+  uint32_t size = iter->end - iter->begin;
+  if (size > _inboxSize) {
+    return HostInboxDropped(APP_MSG_BUFFER_OVERFLOW);
+  }
+
+  memcpy(_inboxBuffer, iter->begin, size);
+  DictionaryIterator received;
+  dict_read_begin_from_buffer(&received, _inboxBuffer, size);
+  _inboxReceived(&received, _messageContext);
+  render();
+  return true;
+}
+
+bool HostInboxDropped(AppMessageResult reason) {
+  if (_messageOpen == false || _inboxDropped == NULL) {
+    return false;
+  }
+
+  _inboxDropped(reason, _messageContext);
+  render();
+  return true;
+}
+
+DictionaryIterator* HostOutboxPending() {
+  return (_outboxState == OUTBOX_SENDING) ? &_outboxIter : NULL;
+}
+
+// The outbox is free again before the callback runs, so the callback can
+// send the next message, as on the watch.
+bool HostOutboxComplete(bool sent, AppMessageResult reason) {
+  if (_outboxState != OUTBOX_SENDING) {
+    return false;
+  }
+
+  uint32_t size = _outboxIter.end - _outboxIter.begin;
+  memcpy(_outboxDone, _outboxBuffer, size);
+  _outboxState = OUTBOX_IDLE;
+
+  DictionaryIterator done;
+  dict_read_begin_from_buffer(&done, _outboxDone, size);
+  if (sent && _outboxSent != NULL) {
+    _outboxSent(&done, _messageContext);
+
+  } else if (sent == false && _outboxFailed != NULL) {
+    _outboxFailed(&done, reason, _messageContext);
+  }
+
+  render();
+  return true;
+}
+
+void HostSetOutboxHandler(void (*handler)(DictionaryIterator *iter)) {
+  _outboxHandler = handler;
+}
+
+void HostSetPersistHandler(void (*handler)(uint32_t key)) {
+  _persistHandler = handler;
+}
+
+void HostSet24HourStyle(bool enabled) {
+  _clock24Hour = enabled;
+}
+
+void HostSetLogFile(FILE *file) {
+  _logFile = file;
+  _logFileSet = true;
+}
+
+void HostLog(const char *fmt, ...) {
+  FILE *file = _logFileSet ? _logFile : stdout;
+  if (file == NULL) {
+    return;
+  }
+
+  time_t now = HostTime(NULL);
+  struct tm *local = HostLocaltime(&now);
+  fprintf(file, "%02d:%02d:%02d.%03d ", local->tm_hour, local->tm_min, local->tm_sec, (int) (_nowMs % 1000));
+
+  va_list args;
+  va_start(args, fmt);
+  vfprintf(file, fmt, args);
+  va_end(args);
+  fputc('\n', file);
+}
+
+void HostSetEventLoop(void (*eventLoop)(void)) {
+  _eventLoop = eventLoop;
+}
+
+void HostPersistClear() {
+  memset(_persist, 0, sizeof(_persist));
+}
+
+bool HostPersistSave(FILE *file) {
+  return fwrite(_persist, sizeof(_persist), 1, file) == 1;
+}
+
+bool HostPersistLoad(FILE *file) {
+  return fread(_persist, sizeof(_persist), 1, file) == 1;
+}
+
+const HostStats* HostGetStats() {
+  return &_stats;
+}
+
+void HostResetStats() {
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+void app_event_loop(void) {
+  if (_eventLoop != NULL) {
+    _eventLoop();
+  }
+}
+
+// Rendering. As on aplite, marking any layer dirty redraws the whole window.
+
+static void render() {
+  if (_dirty == false || _topWindow == NULL) {
+    return;
+  }
+
+  _dirty = false;
+  _stats.frames++;
+
+  GContext ctx = { .fillColor = _topWindow->backgroundColor, .compositingMode = GCompOpAssign };
+  graphics_fill_rect(&ctx, _topWindow->root.frame, 0, GCornerNone);
+  drawLayer(&_topWindow->root, &ctx);
+}
+
+static void drawLayer(Layer *layer, GContext *ctx) {
+  if (layer->hidden) {
+    return;
+  }
+
+  if (layer->update_proc != NULL) {
+    _stats.layerDraws++;
+    layer->update_proc(layer, ctx);
+  }
+
+  for (Layer *child = layer->first_child; child != NULL; child = child->next_sibling) {
+    drawLayer(child, ctx);
+  }
+}
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color) {
+  ctx->fillColor = color;
+}
+
+void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode) {
+  ctx->compositingMode = mode;
+}
+
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask) {
+  _stats.fills++;
+}
+
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect) {
+  _stats.bitmaps++;
+}
+
+GPath* gpath_create(const GPathInfo *init) {
+  GPath *path = calloc(1, sizeof(GPath));
+  path->num_points = init->num_points;
+  path->points = init->points;
+  return path;
+}
+
+void gpath_destroy(GPath *path) {
+  free(path);
+}
+
+void gpath_move_to(GPath *path, GPoint point) {
+  path->offset = point;
+}
+
+void gpath_draw_filled(GContext *ctx, GPath *path) {
+  _stats.fills++;
+}
+
+GFont fonts_get_system_font(const char *font_key) {
+  return font_key;
+}
+
+// Bitmaps. Sizes come from the PNG headers so layout code sees real bounds.
+
+GBitmap* gbitmap_create_with_resource(uint32_t resource_id) {
+  GBitmap *bitmap = calloc(1, sizeof(GBitmap));
+  bitmap->resource_id = resource_id;
+  readPngSize(resource_id, &bitmap->bounds.size);
+  _bitmapBytes += ((bitmap->bounds.size.w + 31) / 32) * 4 * bitmap->bounds.size.h;
+  return bitmap;
+}
+
+GBitmap* gbitmap_create_as_sub_bitmap(const GBitmap *base_bitmap, GRect sub_rect) {
+  GBitmap *bitmap = calloc(1, sizeof(GBitmap));
+  bitmap->resource_id = base_bitmap->resource_id;
+  bitmap->bounds = sub_rect;
+  bitmap->parent = base_bitmap;
+  return bitmap;
+}
+
+void gbitmap_destroy(GBitmap *bitmap) {
+  if (bitmap != NULL && bitmap->parent == NULL) {
+    _bitmapBytes -= ((bitmap->bounds.size.w + 31) / 32) * 4 * bitmap->bounds.size.h;
+  }
+
+  free(bitmap);
+}
+
+static void readPngSize(uint32_t resourceId, GSize *size) {
+  if (resourceId == 0 || resourceId >= sizeof(_resourceFiles) / sizeof(_resourceFiles[0])) {
+    return;
+  }
+
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s", RESOURCES_DIR, _resourceFiles[resourceId]);
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    return;
+  }
+
+  // Width and height are the first fields of the IHDR chunk, big-endian.
+  uint8_t header[24];
+  if (fread(header, 1, sizeof(header), file) == sizeof(header)) {
+    size->w = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+    size->h = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+  }
+
+  fclose(file);
+}
+
+size_t heap_bytes_free(void) {
+  return (_bitmapBytes < HEAP_FREE) ? (HEAP_FREE - _bitmapBytes) : 0;
+}
+
+size_t heap_bytes_used(void) {
+  return _bitmapBytes;
+}
+
+// Layers
+
+Layer* layer_create(GRect frame) {
+  return layer_create_with_data(frame, 0);
+}
+
+Layer* layer_create_with_data(GRect frame, size_t data_size) {
+  Layer *layer = calloc(1, sizeof(Layer) + data_size);
+  layer->frame = frame;
+  layer->data = (data_size > 0) ? (void*) (layer + 1) : NULL;
+  return layer;
+}
+
+void layer_destroy(Layer *layer) {
+  if (layer == NULL) {
+    return;
+  }
+
+  layer_remove_from_parent(layer);
+  for (Layer *child = layer->first_child; child != NULL; child = child->next_sibling) {
+    child->parent = NULL;
+  }
+
+  free(layer);
+}
+
+void* layer_get_data(const Layer *layer) {
+  return layer->data;
+}
+
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc) {
+  layer->update_proc = update_proc;
+}
+
+void layer_mark_dirty(Layer *layer) {
+  _dirty = true;
+}
+
+void layer_set_frame(Layer *layer, GRect frame) {
+  layer->frame = frame;
+  _dirty = true;
+}
+
+GRect layer_get_frame(const Layer *layer) {
+  return layer->frame;
+}
+
+GRect layer_get_bounds(const Layer *layer) {
+  return GRect(0, 0, layer->frame.size.w, layer->frame.size.h);
+}
+
+void layer_set_hidden(Layer *layer, bool hidden) {
+  if (layer->hidden != hidden) {
+    layer->hidden = hidden;
+    _dirty = true;
+  }
+}
+
+bool layer_get_hidden(const Layer *layer) {
+  return layer->hidden;
+}
+
+void layer_remove_from_parent(Layer *child) {
+  Layer *parent = child->parent;
+  if (parent == NULL) {
+    return;
+  }
+
+  for (Layer **link = &parent->first_child; *link != NULL; link = &(*link)->next_sibling) {
+    if (*link == child) {
+      *link = child->next_sibling;
+      break;
+    }
+  }
+
+  child->parent = NULL;
+  child->next_sibling = NULL;
+  _dirty = true;
+}
+
+void layer_add_child(Layer *parent, Layer *child) {
+  layer_remove_from_parent(child);
+
+  Layer **link = &parent->first_child;
+  while (*link != NULL) {
+    link = &(*link)->next_sibling;
+  }
+
+  *link = child;
+  child->parent = parent;
+  _dirty = true;
+}
+
+void layer_insert_above_sibling(Layer *layer, Layer *above_sibling) {
+  layer_remove_from_parent(layer);
+  layer->parent = above_sibling->parent;
+  layer->next_sibling = above_sibling->next_sibling;
+  above_sibling->next_sibling = layer;
+  _dirty = true;
+}
+
+void layer_insert_below_sibling(Layer *layer, Layer *below_sibling) {
+  Layer *parent = below_sibling->parent;
+  if (parent == NULL) {
+    return;
+  }
+
+  layer_remove_from_parent(layer);
+  for (Layer **link = &parent->first_child; *link != NULL; link = &(*link)->next_sibling) {
+    if (*link == below_sibling) {
+      layer->parent = parent;
+      layer->next_sibling = below_sibling;
+      *link = layer;
+      break;
+    }
+  }
+
+  _dirty = true;
+}
+
+// Built-in layers draw through the same graphics calls as custom ones.
+
+static void textLayerUpdate(Layer *layer, GContext *ctx) {
+  TextLayer *textLayer = (TextLayer*) layer;
+  if (textLayer->background_color != GColorClear) {
+    graphics_context_set_fill_color(ctx, textLayer->background_color);
+    graphics_fill_rect(ctx, layer->frame, 0, GCornerNone);
+  }
+}
+
+static void bitmapLayerUpdate(Layer *layer, GContext *ctx) {
+  BitmapLayer *bitmapLayer = (BitmapLayer*) layer;
+  if (bitmapLayer->bitmap != NULL) {
+    graphics_context_set_compositing_mode(ctx, bitmapLayer->compositing_mode);
+    graphics_draw_bitmap_in_rect(ctx, bitmapLayer->bitmap, layer->frame);
+  }
+}
+
+static void inverterLayerUpdate(Layer *layer, GContext *ctx) {
+  graphics_fill_rect(ctx, layer->frame, 0, GCornerNone);
+}
+
+TextLayer* text_layer_create(GRect frame) {
+  TextLayer *textLayer = calloc(1, sizeof(TextLayer));
+  textLayer->layer.frame = frame;
+  textLayer->layer.update_proc = textLayerUpdate;
+  textLayer->background_color = GColorWhite;
+  return textLayer;
+}
+
+void text_layer_destroy(TextLayer *text_layer) {
+  if (text_layer != NULL) {
+    layer_remove_from_parent(&text_layer->layer);
+    free(text_layer);
+  }
+}
+
+Layer* text_layer_get_layer(TextLayer *text_layer) {
+  return &text_layer->layer;
+}
+
+void text_layer_set_text(TextLayer *text_layer, const char *text) {
+  text_layer->text = text;
+  _dirty = true;
+}
+
+void text_layer_set_font(TextLayer *text_layer, GFont font) {
+  text_layer->font = font;
+  _dirty = true;
+}
+
+void text_layer_set_text_alignment(TextLayer *text_layer, GTextAlignment text_alignment) {
+  text_layer->alignment = text_alignment;
+  _dirty = true;
+}
+
+void text_layer_set_background_color(TextLayer *text_layer, GColor color) {
+  text_layer->background_color = color;
+  _dirty = true;
+}
+
+BitmapLayer* bitmap_layer_create(GRect frame) {
+  BitmapLayer *bitmapLayer = calloc(1, sizeof(BitmapLayer));
+  bitmapLayer->layer.frame = frame;
+  bitmapLayer->layer.update_proc = bitmapLayerUpdate;
+  return bitmapLayer;
+}
+
+void bitmap_layer_destroy(BitmapLayer *bitmap_layer) {
+  if (bitmap_layer != NULL) {
+    layer_remove_from_parent(&bitmap_layer->layer);
+    free(bitmap_layer);
+  }
+}
+
+Layer* bitmap_layer_get_layer(const BitmapLayer *bitmap_layer) {
+  return (Layer*) &bitmap_layer->layer;
+}
+
+void bitmap_layer_set_bitmap(BitmapLayer *bitmap_layer, const GBitmap *bitmap) {
+  bitmap_layer->bitmap = bitmap;
+  _dirty = true;
+}
+
+void bitmap_layer_set_compositing_mode(BitmapLayer *bitmap_layer, GCompOp mode) {
+  bitmap_layer->compositing_mode = mode;
+  _dirty = true;
+}
+
+InverterLayer* inverter_layer_create(GRect frame) {
+  InverterLayer *inverterLayer = calloc(1, sizeof(InverterLayer));
+  inverterLayer->layer.frame = frame;
+  inverterLayer->layer.update_proc = inverterLayerUpdate;
+  return inverterLayer;
+}
+
+void inverter_layer_destroy(InverterLayer *inverter_layer) {
+  if (inverter_layer != NULL) {
+    layer_remove_from_parent(&inverter_layer->layer);
+    free(inverter_layer);
+  }
+}
+
+Layer* inverter_layer_get_layer(InverterLayer *inverter_layer) {
+  return &inverter_layer->layer;
+}
+
+// Windows. Only the one window the face pushes is tracked.
+
+Window* window_create(void) {
+  Window *window = calloc(1, sizeof(Window));
+  window->root.frame = GRect(0, 0, 144, 168);
+  window->backgroundColor = GColorWhite;
+  return window;
+}
+
+void window_destroy(Window *window) {
+  if (window == NULL) {
+    return;
+  }
+
+  if (window->loaded) {
+    if (window->handlers.disappear != NULL) {
+      window->handlers.disappear(window);
+    }
+
+    if (window->handlers.unload != NULL) {
+      window->handlers.unload(window);
+    }
+  }
+
+  if (_topWindow == window) {
+    _topWindow = NULL;
+  }
+
+  free(window);
+}
+
+void window_set_window_handlers(Window *window, WindowHandlers handlers) {
+  window->handlers = handlers;
+}
+
+void window_set_background_color(Window *window, GColor background_color) {
+  window->backgroundColor = background_color;
+  _dirty = true;
+}
+
+Layer* window_get_root_layer(const Window *window) {
+  return (Layer*) &window->root;
+}
+
+void window_stack_push(Window *window, bool animated) {
+  _topWindow = window;
+
+  if (window->loaded == false) {
+    window->loaded = true;
+    if (window->handlers.load != NULL) {
+      window->handlers.load(window);
+    }
+  }
+
+  if (window->handlers.appear != NULL) {
+    window->handlers.appear(window);
+  }
+
+  _dirty = true;
+}
+
+// Animations. Only property animations of a layer frame exist on this face.
+
+PropertyAnimation* property_animation_create_layer_frame(Layer *layer, GRect *from_frame, GRect *to_frame) {
+  PropertyAnimation *animation = calloc(1, sizeof(PropertyAnimation));
+  animation->animation.duration_ms = 250;
+  animation->layer = layer;
+  animation->from_current = (from_frame == NULL);
+  animation->from = (from_frame != NULL) ? *from_frame : layer->frame;
+  animation->to = (to_frame != NULL) ? *to_frame : layer->frame;
+  return animation;
+}
+
+void property_animation_destroy(PropertyAnimation *property_animation) {
+  if (property_animation == NULL) {
+    return;
+  }
+
+  animation_unschedule(&property_animation->animation);
+  free(property_animation);
+}
+
+void animation_set_duration(Animation *animation, uint32_t duration_ms) {
+  animation->duration_ms = duration_ms;
+}
+
+void animation_set_curve(Animation *animation, AnimationCurve curve) {
+  animation->curve = curve;
+}
+
+void animation_set_handlers(Animation *animation, AnimationHandlers callbacks, void *context) {
+  animation->handlers = callbacks;
+  animation->context = context;
+}
+
+void animation_schedule(Animation *animation) {
+  animation_unschedule(animation);
+
+  PropertyAnimation *property = (PropertyAnimation*) animation;
+  if (property->from_current) {
+    property->from = property->layer->frame;
+  }
+
+  animation->scheduled = true;
+  animation->start_ms = _nowMs;
+  animation->frame_ms = _nowMs + ANIMATION_FRAME_MS;
+  animation->next = _animations;
+  _animations = animation;
+
+  if (animation->handlers.started != NULL) {
+    animation->handlers.started(animation, animation->context);
+  }
+}
+
+void animation_unschedule(Animation *animation) {
+  if (animation->scheduled == false) {
+    return;
+  }
+
+  removeAnimation(animation);
+  if (animation->handlers.stopped != NULL) {
+    animation->handlers.stopped(animation, false, animation->context);
+  }
+}
+
+static void removeAnimation(Animation *animation) {
+  for (Animation **link = &_animations; *link != NULL; link = &(*link)->next) {
+    if (*link == animation) {
+      *link = animation->next;
+      break;
+    }
+  }
+
+  animation->scheduled = false;
+  animation->next = NULL;
+}
+
+// Frames are interpolated linearly whatever the curve; only the end points
+// and timing matter to the face.
+static void stepAnimation(Animation *animation) {
+  PropertyAnimation *property = (PropertyAnimation*) animation;
+  int64_t endMs = animation->start_ms + animation->duration_ms;
+  int64_t elapsed = _nowMs - animation->start_ms;
+  _stats.animationFrames++;
+
+  if (_nowMs >= endMs) {
+    layer_set_frame(property->layer, property->to);
+    removeAnimation(animation);
+
+    if (animation->handlers.stopped != NULL) {
+      animation->handlers.stopped(animation, true, animation->context);
+    }
+    return;
+  }
+
+  GRect from = property->from;
+  GRect to = property->to;
+  int32_t duration = animation->duration_ms;
+  layer_set_frame(property->layer, GRect(from.origin.x + (to.origin.x - from.origin.x) * elapsed / duration,
+                                         from.origin.y + (to.origin.y - from.origin.y) * elapsed / duration,
+                                         from.size.w + (to.size.w - from.size.w) * elapsed / duration,
+                                         from.size.h + (to.size.h - from.size.h) * elapsed / duration));
+
+  animation->frame_ms = (_nowMs + ANIMATION_FRAME_MS < endMs) ? (_nowMs + ANIMATION_FRAME_MS) : endMs;
+}
+
+// Timers. Handles are ids rather than pointers, so a stale handle is harmless.
+
+AppTimer* app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data) {
+  for (uint16_t i = 0; i < TIMER_SLOTS; i++) {
+    if (_timers[i].id == 0) {
+      _timers[i] = (HostTimer) {
+        .id = _nextTimerId++,
+        .dueMs = _nowMs + timeout_ms,
+        .callback = callback,
+        .data = callback_data,
+      };
+      return (AppTimer*) (uintptr_t) _timers[i].id;
+    }
+  }
+
+  return NULL;
+}
+
+bool app_timer_reschedule(AppTimer *timer_handle, uint32_t new_timeout_ms) {
+  uint32_t id = (uint32_t) (uintptr_t) timer_handle;
+  for (uint16_t i = 0; i < TIMER_SLOTS; i++) {
+    if (id != 0 && _timers[i].id == id) {
+      _timers[i].dueMs = _nowMs + new_timeout_ms;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void app_timer_cancel(AppTimer *timer_handle) {
+  uint32_t id = (uint32_t) (uintptr_t) timer_handle;
+  for (uint16_t i = 0; i < TIMER_SLOTS; i++) {
+    if (id != 0 && _timers[i].id == id) {
+      _timers[i].id = 0;
+    }
+  }
+}
+
+// Services
+
+void tick_timer_service_subscribe(TimeUnits tick_units, TickHandler handler) {
+  _tickHandler = handler;
+}
+
+void tick_timer_service_unsubscribe(void) {
+  _tickHandler = NULL;
+}
+
+void bluetooth_connection_service_subscribe(BluetoothConnectionHandler handler) {
+  _bluetoothHandler = handler;
+}
+
+void bluetooth_connection_service_unsubscribe(void) {
+  _bluetoothHandler = NULL;
+}
+
+bool bluetooth_connection_service_peek(void) {
+  return _connected;
+}
+
+void battery_state_service_subscribe(BatteryStateHandler handler) {
+  _batteryHandler = handler;
+}
+
+void battery_state_service_unsubscribe(void) {
+  _batteryHandler = NULL;
+}
+
+BatteryChargeState battery_state_service_peek(void) {
+  return _battery;
+}
+
+void app_focus_service_subscribe(AppFocusHandler handler) {
+  _focusHandler = handler;
+}
+
+void app_focus_service_unsubscribe(void) {
+  _focusHandler = NULL;
+}
+
+bool clock_is_24h_style(void) {
+  return _clock24Hour;
+}
+
+void vibes_short_pulse(void) {
+  _stats.vibes++;
+  HostLog("vibe");
+}
+
+// Dictionaries, laid out as on the watch: a tuple count, then packed tuples.
+
+DictionaryResult dict_write_begin(DictionaryIterator *iter, uint8_t *buffer, uint16_t size) {
+  if (iter == NULL || buffer == NULL || size < 1) {
+    return DICT_INVALID_ARGS;
+  }
+
+  buffer[0] = 0;
+  iter->begin = buffer;
+  iter->end = buffer + size;
+  iter->cursor = buffer + 1;
+  iter->size = size;
+  return DICT_OK;
+}
+
+static DictionaryResult writeTuple(DictionaryIterator *iter, uint32_t key, TupleType type, const void *data,
+                                   uint16_t length) {
+  if (iter->cursor + TUPLE_HEADER_SIZE + length > iter->begin + iter->size) {
+    return DICT_NOT_ENOUGH_STORAGE;
+  }
+
+  Tuple *tuple = (Tuple*) iter->cursor;
+  tuple->key = key;
+  tuple->type = type;
+  tuple->length = length;
+  memcpy(tuple->value, data, length);
+  iter->cursor += TUPLE_HEADER_SIZE + length;
+  iter->begin[0]++;
+  return DICT_OK;
+}
+
+DictionaryResult dict_write_data(DictionaryIterator *iter, uint32_t key, const uint8_t *data, uint16_t size) {
+  return writeTuple(iter, key, TUPLE_BYTE_ARRAY, data, size);
+}
+
+DictionaryResult dict_write_cstring(DictionaryIterator *iter, uint32_t key, const char *cstring) {
+  return writeTuple(iter, key, TUPLE_CSTRING, cstring, (cstring != NULL) ? strlen(cstring) + 1 : 0);
+}
+
+DictionaryResult dict_write_int(DictionaryIterator *iter, uint32_t key, const void *integer, uint8_t width_bytes,
+                                bool is_signed) {
+  if (width_bytes != 1 && width_bytes != 2 && width_bytes != 4) {
+    return DICT_INVALID_ARGS;
+  }
+
+  return writeTuple(iter, key, is_signed ? TUPLE_INT : TUPLE_UINT, integer, width_bytes);
+}
+
+DictionaryResult dict_write_uint8(DictionaryIterator *iter, uint32_t key, uint8_t value) {
+  return dict_write_int(iter, key, &value, sizeof(value), false);
+}
+
+DictionaryResult dict_write_int32(DictionaryIterator *iter, uint32_t key, int32_t value) {
+  return dict_write_int(iter, key, &value, sizeof(value), true);
+}
+
+DictionaryResult dict_write_tuplet(DictionaryIterator *iter, const Tuplet *tuplet) {
+  switch (tuplet->type) {
+    case TUPLE_BYTE_ARRAY:
+      return dict_write_data(iter, tuplet->key, tuplet->bytes.data, tuplet->bytes.length);
+
+    case TUPLE_CSTRING:
+      return dict_write_cstring(iter, tuplet->key, tuplet->cstring.data);
+
+    case TUPLE_UINT:
+    case TUPLE_INT:
+      return dict_write_int(iter, tuplet->key, &tuplet->integer.storage, tuplet->integer.width,
+                            tuplet->type == TUPLE_INT);
+  }
+
+  return DICT_INVALID_ARGS;
+}
+
+uint32_t dict_write_end(DictionaryIterator *iter) {
+  iter->end = iter->cursor;
+  iter->cursor = iter->begin + 1;
+  return iter->end - iter->begin;
+}
+
+Tuple* dict_read_begin_from_buffer(DictionaryIterator *iter, const uint8_t *buffer, uint16_t size) {
+  iter->begin = (uint8_t*) buffer;
+  iter->end = (uint8_t*) buffer + size;
+  iter->size = size;
+  return dict_read_first(iter);
+}
+
+Tuple* dict_read_first(DictionaryIterator *iter) {
+  iter->cursor = iter->begin + 1;
+  return dict_read_next(iter);
+}
+
+Tuple* dict_read_next(DictionaryIterator *iter) {
+  if (iter->cursor + TUPLE_HEADER_SIZE > iter->end) {
+    return NULL;
+  }
+
+  Tuple *tuple = (Tuple*) iter->cursor;
+  if (iter->cursor + TUPLE_HEADER_SIZE + tuple->length > iter->end) {
+    return NULL;
+  }
+
+  iter->cursor += TUPLE_HEADER_SIZE + tuple->length;
+  return tuple;
+}
+
+Tuple* dict_find(const DictionaryIterator *iter, uint32_t key) {
+  DictionaryIterator copy = *iter;
+  for (Tuple *tuple = dict_read_first(&copy); tuple != NULL; tuple = dict_read_next(&copy)) {
+    if (tuple->key == key) {
+      return tuple;
+    }
+  }
+
+  return NULL;
+}
+
+// AppMessage
+
+AppMessageResult app_message_open(uint32_t size_inbound, uint32_t size_outbound) {
+  if (size_inbound > INBOX_SIZE_MAXIMUM || size_outbound > OUTBOX_SIZE_MAXIMUM) {
+    return APP_MSG_OUT_OF_MEMORY;
+  }
+
+  _inboxSize = size_inbound;
+  _outboxSize = size_outbound;
+  _outboxState = OUTBOX_IDLE;
+  _messageOpen = true;
+  return APP_MSG_OK;
+}
+
+uint32_t app_message_inbox_size_maximum(void) {
+  return INBOX_SIZE_MAXIMUM;
+}
+
+uint32_t app_message_outbox_size_maximum(void) {
+  return OUTBOX_SIZE_MAXIMUM;
+}
+
+void* app_message_set_context(void *context) {
+  void *previous = _messageContext;
+  _messageContext = context;
+  return previous;
+}
+
+AppMessageInboxReceived app_message_register_inbox_received(AppMessageInboxReceived received_callback) {
+  AppMessageInboxReceived previous = _inboxReceived;
+  _inboxReceived = received_callback;
+  return previous;
+}
+
+AppMessageInboxDropped app_message_register_inbox_dropped(AppMessageInboxDropped dropped_callback) {
+  AppMessageInboxDropped previous = _inboxDropped;
+  _inboxDropped = dropped_callback;
+  return previous;
+}
+
+AppMessageOutboxSent app_message_register_outbox_sent(AppMessageOutboxSent sent_callback) {
+  AppMessageOutboxSent previous = _outboxSent;
+  _outboxSent = sent_callback;
+  return previous;
+}
+
+AppMessageOutboxFailed app_message_register_outbox_failed(AppMessageOutboxFailed failed_callback) {
+  AppMessageOutboxFailed previous = _outboxFailed;
+  _outboxFailed = failed_callback;
+  return previous;
+}
+
+AppMessageResult app_message_outbox_begin(DictionaryIterator **iterator) {
+  *iterator = NULL;
+
+  if (_messageOpen == false) {
+    return APP_MSG_INVALID_ARGS;
+  }
+
+  if (_outboxState != OUTBOX_IDLE) {
+    return APP_MSG_BUSY;
+  }
+
+  dict_write_begin(&_outboxIter, _outboxBuffer, _outboxSize);
+  _outboxState = OUTBOX_WRITING;
+  *iterator = &_outboxIter;
+  return APP_MSG_OK;
+}
+
+AppMessageResult app_message_outbox_send(void) {
+  if (_outboxState == OUTBOX_SENDING) {
+    return APP_MSG_BUSY;
+  }
+
+  if (_outboxState != OUTBOX_WRITING) {
+    return APP_MSG_INVALID_ARGS;
+  }
+
+  _outboxState = OUTBOX_SENDING;
+  _stats.outboxSent++;
+
+  if (_outboxHandler != NULL) {
+    _outboxHandler(&_outboxIter);
+  }
+  return APP_MSG_OK;
+}
+
+// Persistent storage
+
+static PersistSlot* findPersist(uint32_t key) {
+  for (uint16_t i = 0; i < PERSIST_SLOTS; i++) {
+    if (_persist[i].used && _persist[i].key == key) {
+      return &_persist[i];
+    }
+  }
+
+  return NULL;
+}
+
+static PersistSlot* writePersist(uint32_t key, const void *data, size_t size) {
+  PersistSlot *slot = findPersist(key);
+  for (uint16_t i = 0; slot == NULL && i < PERSIST_SLOTS; i++) {
+    if (_persist[i].used == false) {
+      slot = &_persist[i];
+    }
+  }
+
+  if (slot == NULL) {
+    return NULL;
+  }
+
+  slot->used = true;
+  slot->key = key;
+  slot->size = (size < PERSIST_DATA_MAX_LENGTH) ? size : PERSIST_DATA_MAX_LENGTH;
+  memcpy(slot->data, data, slot->size);
+  _stats.persistWrites++;
+
+  if (_persistHandler != NULL) {
+    _persistHandler(key);
+  }
+  return slot;
+}
+
+bool persist_exists(uint32_t key) {
+  return findPersist(key) != NULL;
+}
+
+int persist_get_size(uint32_t key) {
+  PersistSlot *slot = findPersist(key);
+  return (slot != NULL) ? slot->size : E_DOES_NOT_EXIST;
+}
+
+int32_t persist_read_int(uint32_t key) {
+  int32_t value = 0;
+  PersistSlot *slot = findPersist(key);
+  if (slot != NULL && slot->size == sizeof(value)) {
+    memcpy(&value, slot->data, sizeof(value));
+  }
+
+  return value;
+}
+
+int persist_read_data(uint32_t key, void *buffer, size_t buffer_size) {
+  PersistSlot *slot = findPersist(key);
+  if (slot == NULL) {
+    return E_DOES_NOT_EXIST;
+  }
+
+  size_t size = (slot->size < buffer_size) ? slot->size : buffer_size;
+  memcpy(buffer, slot->data, size);
+  return size;
+}
+
+status_t persist_write_int(uint32_t key, int32_t value) {
+  return (writePersist(key, &value, sizeof(value)) != NULL) ? (status_t) sizeof(value) : E_DOES_NOT_EXIST;
+}
+
+int persist_write_data(uint32_t key, const void *data, size_t size) {
+  PersistSlot *slot = writePersist(key, data, size);
+  return (slot != NULL) ? slot->size : E_DOES_NOT_EXIST;
+}
+
+status_t persist_delete(uint32_t key) {
+  PersistSlot *slot = findPersist(key);
+  if (slot == NULL) {
+    return E_DOES_NOT_EXIST;
+  }
+
+  slot->used = false;
+  return S_SUCCESS;
+}
+
+// Logging
+
+void app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...) {
+  char text[256];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(text, sizeof(text), fmt, args);
+  va_end(args);
+
+  HostLog("log %s:%d %s", src_filename, src_line_number, text);
+}
\ No newline at end of file
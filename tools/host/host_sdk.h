@@ -0,0 +1,67 @@
+#pragma once
+// Driver side of the host SDK in pebble.h: sets the simulated clock, delivers
+// service events and AppMessages to the watchface, and reports what it did.
+#include <stdio.h>
+#include <pebble.h>
+
+typedef struct {
+  uint32_t frames;            // render passes, one per batch of dirty layers
+  uint32_t layerDraws;        // visible layers drawn across all frames
+  uint32_t fills;             // graphics_fill_rect and gpath_draw_filled calls
+  uint32_t bitmaps;           // graphics_draw_bitmap_in_rect calls
+  uint32_t timersFired;
+  uint32_t animationFrames;
+  uint32_t vibes;
+  uint32_t outboxSent;
+  uint32_t persistWrites;
+} HostStats;
+
+// Watch-local milliseconds since the epoch.
+void HostSetTime(int64_t ms);
+int64_t HostNowMs();
+
+// Run timers and animation frames that fall due up to ms, redrawing after
+// each, then leave the clock at ms.
+void HostAdvanceTo(int64_t ms);
+
+// Earliest pending timer or animation frame, or -1 when there is none.
+int64_t HostNextDue();
+
+// Service events. Each returns false when the face is not subscribed.
+bool HostTick(TimeUnits unitsChanged);
+bool HostBluetooth(bool connected);
+bool HostBattery(BatteryChargeState state);
+bool HostFocus(bool inFocus);
+
+// AppMessage. HostInbox takes a dictionary written with dict_write_begin.
+bool HostInbox(DictionaryIterator *iter);
+bool HostInboxDropped(AppMessageResult reason);
+DictionaryIterator* HostOutboxPending();
+bool HostOutboxComplete(bool sent, AppMessageResult reason);
+
+// Called for every message the face hands to app_message_outbox_send.
+void HostSetOutboxHandler(void (*handler)(DictionaryIterator *iter));
+
+// Called for every persist_write_int or persist_write_data.
+void HostSetPersistHandler(void (*handler)(uint32_t key));
+
+// Environment the face queries.
+void HostSet24HourStyle(bool enabled);
+
+// Where app_log output and host events are written, NULL for nowhere.
+void HostSetLogFile(FILE *file);
+void HostLog(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+// Called by app_event_loop; the driver feeds events until it returns.
+void HostSetEventLoop(void (*eventLoop)(void));
+
+// Drop all persisted values, as a fresh install would.
+void HostPersistClear();
+
+// Persisted values as raw bytes, to carry them between app runs that each
+// get a fresh process (and so fresh statics).
+bool HostPersistSave(FILE *file);
+bool HostPersistLoad(FILE *file);
+
+const HostStats* HostGetStats();
+void HostResetStats();
\ No newline at end of file
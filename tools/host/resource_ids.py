@@ -0,0 +1,22 @@
+#!/usr/bin/env python
+"""Write the resource_ids.auto.h used by the host pebble.h.
+
+    python tools/host/resource_ids.py appinfo.json build/host/resource_ids.auto.h
+
+Resource IDs are numbered from 1 in appinfo.json order, as the SDK does, and
+each one's file is listed so the host can read the real bitmap sizes.
+"""
+
+import json
+import sys
+
+if __name__ == '__main__':
+    media = json.load(open(sys.argv[1]))['resources']['media']
+    lines = ['#pragma once', '// Generated from appinfo.json by tools/host/resource_ids.py.', '', 'enum {']
+    for index, resource in enumerate(media):
+        lines.append('  RESOURCE_ID_%s = %d,' % (resource['name'], index + 1))
+    lines.append('};')
+    lines.append('')
+    lines.append('#define HOST_RESOURCE_FILES { NULL, %s }' % ', '.join('"%s"' % r['file'] for r in media))
+    with open(sys.argv[2], 'w') as output:
+        output.write('\n'.join(lines) + '\n')
@@ -0,0 +1,423 @@
+// Replays a trace exported by pebble-js-app.js through the real watchface code.
+//
+//   make -C tools/host
+//   build/host/trace_replay [--quiet] [--session N] [--setting KEY=VALUE ...] [FILE]
+//
+// FILE (or stdin) holds the phone log with the "Trace <hex>" dump. Every
+// session in the dump (START to STOP) runs main.c in a fresh process on the
+// simulated clock: inputs such as ticks, Bluetooth, battery, focus, inbox
+// messages and outbox results are delivered at their recorded times, and what
+// the face records in turn (including its own animation and outbox events) is
+// compared with the dump. Persisted values carry over from session to session
+// as on the watch; --setting seeds them before the first one (or before the
+// only one, with --session).
+//
+// This file stands in for trace_recorder.c, collecting the face's records.
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <pebble.h>
+#include "host_sdk.h"
+#include "common.h"
+#include "settings.h"
+#include "trace_recorder.h"
+
+#define TRACE_RECORD_SIZE 8
+#define MAX_RECORDS 4096
+#define MAX_INPUT (1 << 22)
+
+typedef struct {
+  int64_t ms;
+  TraceType type;
+  uint16_t value;
+} ReplayRecord;
+
+// Same names as TRACE_TYPES in pebble-js-app.js.
+static const char *_typeNames[] = {
+  "start", "stop", "tick", "bluetooth", "battery", "inbox received", "inbox dropped",
+  "outbox sent", "outbox failed", "animation start", "animation stop", "focus",
+};
+
+static ReplayRecord _input[MAX_RECORDS];
+static uint16_t _inputCount = 0;
+static ReplayRecord _replayed[MAX_RECORDS];
+static uint16_t _replayedCount = 0;
+static const ReplayRecord *_session = NULL;
+static uint16_t _sessionCount = 0;
+static bool _quiet = false;
+
+int FillerupMain(void);
+
+static const char* typeName(TraceType type) {
+  return (type < sizeof(_typeNames) / sizeof(_typeNames[0])) ? _typeNames[type] : "unknown";
+}
+
+// Trace recorder
+
+void TraceLoad() {
+  TraceEvent(TRACE_START, 0);
+}
+
+void TraceEvent(TraceType type, uint16_t value) {
+  if (_replayedCount < MAX_RECORDS) {
+    _replayed[_replayedCount++] = (ReplayRecord) { .ms = HostNowMs(), .type = type, .value = value };
+  }
+}
+
+void TraceCheckpoint() {
+}
+
+void TraceSave() {
+  TraceEvent(TRACE_STOP, 0);
+}
+
+void TraceStartExport() {
+}
+
+bool TraceSendNext() {
+  return false;
+}
+
+void TraceSent() {
+}
+
+void TraceSendFailed() {
+}
+
+// Input
+
+// The dump is the longest run of hex digits in the log that holds whole records.
+static bool parseTrace(const char *text) {
+  const char *best = NULL;
+  size_t bestLength = 0;
+
+  for (const char *cursor = text; *cursor != '\0'; ) {
+    size_t length = strspn(cursor, "0123456789abcdefABCDEF");
+    if (length > bestLength && length % (TRACE_RECORD_SIZE * 2) == 0) {
+      best = cursor;
+      bestLength = length;
+    }
+
+    cursor += (length > 0) ? length : 1;
+  }
+
+  if (best == NULL) {
+    return false;
+  }
+
+  for (size_t offset = 0; offset < bestLength && _inputCount < MAX_RECORDS; offset += TRACE_RECORD_SIZE * 2) {
+    uint8_t bytes[TRACE_RECORD_SIZE];
+    for (uint16_t i = 0; i < TRACE_RECORD_SIZE; i++) {
+      sscanf(best + offset + i * 2, "%2hhx", &bytes[i]);
+    }
+
+    // Little-endian { uint32 seconds; uint16 type << 10 | ms; uint16 value }.
+    uint32_t seconds = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+    uint16_t typeMs = bytes[4] | (bytes[5] << 8);
+    _input[_inputCount++] = (ReplayRecord) {
+      .ms = (int64_t) seconds * 1000 + (typeMs & 0x3FF),
+      .type = typeMs >> 10,
+      .value = bytes[6] | (bytes[7] << 8),
+    };
+  }
+
+  return true;
+}
+
+// Event loop
+
+static int32_t settingValue(uint32_t key) {
+  if (persist_exists(key)) {
+    return persist_read_int(key);
+  }
+
+  switch (key) {
+    case KEY_CURRENT_VERSION:
+      return INSTALLED_VERSION;
+
+    case KEY_BLUETOOTH_VIBRATE:
+      return 1;
+
+    case KEY_HOUR_VIBRATE_START:
+      return 9;
+
+    case KEY_HOUR_VIBRATE_END:
+      return 18;
+  }
+
+  return 0;
+}
+
+// Only the first key of an inbox message is recorded. A settings key stands
+// for the whole configuration page, which is resent with the values the face
+// holds, so the replay exercises the same path without changing them.
+static void deliverInbox(uint16_t firstKey) {
+  static const uint32_t settingKeys[] = {
+    KEY_CURRENT_VERSION, KEY_HOUR_VIBRATE, KEY_HOUR_VIBRATE_START, KEY_HOUR_VIBRATE_END, KEY_BLUETOOTH_VIBRATE,
+  };
+
+  uint8_t buffer[256];
+  DictionaryIterator iter;
+  dict_write_begin(&iter, buffer, app_message_inbox_size_maximum());
+
+  bool settings = false;
+  for (uint16_t i = 0; i < sizeof(settingKeys) / sizeof(settingKeys[0]); i++) {
+    settings = settings || (settingKeys[i] == firstKey);
+  }
+
+  dict_write_int32(&iter, firstKey, settings ? settingValue(firstKey) : 0);
+  for (uint16_t i = 0; settings && i < sizeof(settingKeys) / sizeof(settingKeys[0]); i++) {
+    if (settingKeys[i] != firstKey) {
+      dict_write_int32(&iter, settingKeys[i], settingValue(settingKeys[i]));
+    }
+  }
+
+  dict_write_end(&iter);
+  HostInbox(&iter);
+}
+
+// Log and trace exports are not recorded, so their acks are not in the dump.
+static void ackExports() {
+  for (DictionaryIterator *iter = HostOutboxPending(); iter != NULL; iter = HostOutboxPending()) {
+    Tuple *tuple = dict_read_first(iter);
+    if (tuple == NULL || (tuple->key != KEY_LOG_FILE && tuple->key != KEY_TRACE_INDEX)) {
+      return;
+    }
+
+    HostOutboxComplete(true, APP_MSG_OK);
+  }
+}
+
+static void printOutbox(DictionaryIterator *iter) {
+  char text[128];
+  int length = snprintf(text, sizeof(text), "outbox");
+  for (Tuple *tuple = dict_read_first(iter); tuple != NULL && length < (int) sizeof(text); tuple = dict_read_next(iter)) {
+    if (tuple->type == TUPLE_INT || tuple->type == TUPLE_UINT) {
+      length += snprintf(text + length, sizeof(text) - length, " %u=%d", (unsigned) tuple->key,
+                         (tuple->length == 4) ? (int) tuple->value->int32 : (int) tuple->value->uint8);
+    } else {
+      length += snprintf(text + length, sizeof(text) - length, " %u=[%u bytes]", (unsigned) tuple->key,
+                         (unsigned) tuple->length);
+    }
+  }
+
+  HostLog("%s", text);
+}
+
+static void replaySession(void) {
+  for (uint16_t i = 1; i < _sessionCount; i++) {
+    const ReplayRecord *record = &_session[i];
+    HostAdvanceTo(record->ms);
+
+    // Inputs are logged; the face's own events show up as what they cause.
+    if (record->type != TRACE_STOP && record->type != TRACE_ANIMATION_START &&
+        record->type != TRACE_ANIMATION_STOP) {
+      HostLog("%s %u", typeName(record->type), (unsigned) record->value);
+    }
+
+    switch (record->type) {
+      case TRACE_STOP:
+        return;
+
+      case TRACE_TICK:
+        HostTick(record->value);
+        break;
+
+      case TRACE_BLUETOOTH:
+        HostBluetooth(record->value != 0);
+        break;
+
+      case TRACE_BATTERY:
+        HostBattery((BatteryChargeState) {
+          .charge_percent = record->value & 0xFF,
+          .is_charging = (record->value & 0x100) != 0,
+          .is_plugged = (record->value & 0x100) != 0,
+        });
+        break;
+
+      case TRACE_INBOX_RECEIVED:
+        deliverInbox(record->value);
+        break;
+
+      case TRACE_INBOX_DROPPED:
+        HostInboxDropped(record->value);
+        break;
+
+      case TRACE_OUTBOX_SENT:
+        HostOutboxComplete(true, APP_MSG_OK);
+        break;
+
+      case TRACE_OUTBOX_FAILED:
+        HostOutboxComplete(false, record->value);
+        break;
+
+      case TRACE_FOCUS:
+        HostFocus(record->value != 0);
+        break;
+
+      default:
+        // Started and stopped by the face itself, which the comparison checks.
+        break;
+    }
+
+    ackExports();
+  }
+}
+
+// Compare what the face recorded with the dump. Times of the face's own
+// events (animations) are reported but not compared.
+static bool compareSession(uint16_t number) {
+  uint16_t expectedCount = _sessionCount;
+  uint16_t replayedCount = _replayedCount;
+  int64_t maxDrift = 0;
+
+  // A session still running when the trace was exported has no STOP yet.
+  if (_session[expectedCount - 1].type != TRACE_STOP && replayedCount > 0 &&
+      _replayed[replayedCount - 1].type == TRACE_STOP) {
+    replayedCount--;
+  }
+
+  for (uint16_t i = 0; i < expectedCount || i < replayedCount; i++) {
+    const ReplayRecord *expected = (i < expectedCount) ? &_session[i] : NULL;
+    const ReplayRecord *replayed = (i < replayedCount) ? &_replayed[i] : NULL;
+
+    if (expected == NULL || replayed == NULL || expected->type != replayed->type ||
+        expected->value != replayed->value) {
+      printf("session %u diverged at record %u: recorded %s %u, replayed %s %u\n", (unsigned) number, (unsigned) i,
+             (expected != NULL) ? typeName(expected->type) : "nothing", (expected != NULL) ? expected->value : 0,
+             (replayed != NULL) ? typeName(replayed->type) : "nothing", (replayed != NULL) ? replayed->value : 0);
+      return false;
+    }
+
+    int64_t drift = llabs(replayed->ms - expected->ms);
+    if (drift > maxDrift) {
+      maxDrift = drift;
+    }
+  }
+
+  const HostStats *stats = HostGetStats();
+  printf("session %u matches: %u records over %lld s, largest time difference %lld ms\n", (unsigned) number,
+         (unsigned) expectedCount, (long long) ((_session[expectedCount - 1].ms - _session[0].ms) / 1000),
+         (long long) maxDrift);
+  printf("  %u frames, %u layer draws, %u fills, %u bitmaps, %u animation frames, %u timers, %u vibes, "
+         "%u outbox, %u persist writes\n",
+         stats->frames, stats->layerDraws, stats->fills, stats->bitmaps, stats->animationFrames,
+         stats->timersFired, stats->vibes, stats->outboxSent, stats->persistWrites);
+  return true;
+}
+
+// Run one session in a child process, so main.c starts from fresh statics as
+// it would on the watch, and take the persisted values back from it.
+static bool runSession(uint16_t number) {
+  int pipes[2];
+  if (pipe(pipes) != 0) {
+    return false;
+  }
+
+  fflush(stdout);
+  pid_t child = fork();
+  if (child == 0) {
+    close(pipes[0]);
+    HostSetLogFile(_quiet ? NULL : stdout);
+    HostSetOutboxHandler(printOutbox);
+    HostSetEventLoop(replaySession);
+    HostSetTime(_session[0].ms);
+    HostResetStats();
+    HostLog("session %u", (unsigned) number);
+
+    FillerupMain();
+    bool matched = compareSession(number);
+
+    FILE *output = fdopen(pipes[1], "wb");
+    HostPersistSave(output);
+    fclose(output);
+    exit(matched ? 0 : 1);
+  }
+
+  close(pipes[1]);
+  FILE *input = fdopen(pipes[0], "rb");
+  bool loaded = HostPersistLoad(input);
+  fclose(input);
+
+  int status = 0;
+  waitpid(child, &status, 0);
+  return loaded && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(int argc, char **argv) {
+  const char *path = NULL;
+  int onlySession = 0;
+
+  for (int i = 1; i < argc; i++) {
+    uint32_t key;
+    int32_t value;
+
+    if (strcmp(argv[i], "--quiet") == 0) {
+      _quiet = true;
+
+    } else if (strcmp(argv[i], "--session") == 0 && i + 1 < argc) {
+      onlySession = atoi(argv[++i]);
+
+    } else if (strcmp(argv[i], "--setting") == 0 && i + 1 < argc && sscanf(argv[++i], "%u=%d", &key, &value) == 2) {
+      persist_write_int(key, value);
+
+    } else if (argv[i][0] != '-' && path == NULL) {
+      path = argv[i];
+
+    } else {
+      fprintf(stderr, "usage: %s [--quiet] [--session N] [--setting KEY=VALUE ...] [FILE]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  FILE *file = (path != NULL) ? fopen(path, "r") : stdin;
+  if (file == NULL) {
+    perror(path);
+    return 2;
+  }
+
+  static char text[MAX_INPUT + 1];
+  size_t length = fread(text, 1, MAX_INPUT, file);
+  text[length] = '\0';
+  if (file != stdin) {
+    fclose(file);
+  }
+
+  if (parseTrace(text) == false) {
+    fprintf(stderr, "no trace dump found\n");
+    return 2;
+  }
+
+  uint16_t first = 0;
+  while (first < _inputCount && _input[first].type != TRACE_START) {
+    first++;
+  }
+
+  if (first > 0) {
+    printf("skipping %u records from before the oldest recorded start\n", (unsigned) first);
+  }
+
+  bool matched = true;
+  uint16_t number = 0;
+  for (uint16_t start = first; start < _inputCount; start += _sessionCount) {
+    _sessionCount = 1;
+    while (start + _sessionCount < _inputCount && _input[start + _sessionCount - 1].type != TRACE_STOP &&
+           _input[start + _sessionCount].type != TRACE_START) {
+      _sessionCount++;
+    }
+
+    _session = &_input[start];
+    number++;
+    if (onlySession != 0 && number != onlySession) {
+      continue;
+    }
+
+    matched = runSession(number) && matched;
+  }
+
+  if (number == 0) {
+    printf("no complete session in the trace\n");
+  }
+
+  return matched ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#!/usr/bin/env python
+"""Generate the status bar glyph strip used by src/status_layer.c.
+
+    python tools/status_glyphs.py
+
+Writes resources/images/status_glyphs.png, a single 1-bit strip holding the
+digits, "%" and the two Bluetooth words, and prints the C table of glyph
+offsets and widths to paste into status_layer.c.
+
+The glyphs below are a hand-drawn 5x9 pixel font, not FONT_KEY_GOTHIC_14: that
+system font is not available as a file to rasterise, and SDK 2 cannot draw text
+into a bitmap on the watch. The strings and their placement are the ones the
+Gothic 14 text had, but the letterforms are visibly different.
+"""
+
+import os
+import struct
+import zlib
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+HEIGHT = 9
+SPACING = 1
+
+CHARACTERS = {
+    '0': ['.###.', '#...#', '#...#', '#...#', '#...#', '#...#', '#...#', '#...#', '.###.'],
+    '1': ['..#..', '.##..', '#.#..', '..#..', '..#..', '..#..', '..#..', '..#..', '..#..'],
+    '2': ['.###.', '#...#', '....#', '....#', '...#.', '..#..', '.#...', '#....', '#####'],
+    '3': ['.###.', '#...#', '....#', '....#', '..##.', '....#', '....#', '#...#', '.###.'],
+    '4': ['...#.', '..##.', '.#.#.', '#..#.', '#..#.', '#####', '...#.', '...#.', '...#.'],
+    '5': ['#####', '#....', '#....', '####.', '....#', '....#', '....#', '#...#', '.###.'],
+    '6': ['.###.', '#...#', '#....', '#....', '####.', '#...#', '#...#', '#...#', '.###.'],
+    '7': ['#####', '....#', '...#.', '...#.', '..#..', '..#..', '.#...', '.#...', '.#...'],
+    '8': ['.###.', '#...#', '#...#', '#...#', '.###.', '#...#', '#...#', '#...#', '.###.'],
+    '9': ['.###.', '#...#', '#...#', '#...#', '.####', '....#', '....#', '#...#', '.###.'],
+    '%': ['.#...#', '#.#..#', '.#..#.', '...#..', '...#..', '..#...', '.#..#.', '.#.#.#', '#...#.'],
+    'C': ['.###.', '#...#', '#....', '#....', '#....', '#....', '#....', '#...#', '.###.'],
+    'D': ['####.', '#...#', '#...#', '#...#', '#...#', '#...#', '#...#', '#...#', '####.'],
+    'c': ['....', '....', '....', '.###', '#...', '#...', '#...', '#...', '.###'],
+    'd': ['....#', '....#', '....#', '.####', '#...#', '#...#', '#...#', '#...#', '.####'],
+    'e': ['.....', '.....', '.....', '.###.', '#...#', '#####', '#....', '#...#', '.###.'],
+    'i': ['.', '#', '.', '#', '#', '#', '#', '#', '#'],
+    'n': ['.....', '.....', '.....', '####.', '#...#', '#...#', '#...#', '#...#', '#...#'],
+    'o': ['.....', '.....', '.....', '.###.', '#...#', '#...#', '#...#', '#...#', '.###.'],
+    's': ['....', '....', '....', '.###', '#...', '.##.', '...#', '...#', '###.'],
+    't': ['...', '.#.', '.#.', '###', '.#.', '.#.', '.#.', '.#.', '..#'],
+}
+
+# Glyphs in strip order, matching the StatusGlyph enum in status_layer.h.
+GLYPHS = ['0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '%', 'Connected', 'Disconnected']
+
+
+def render(text):
+    rows = [''] * HEIGHT
+    for index, character in enumerate(text):
+        for y in range(HEIGHT):
+            rows[y] += ('.' * SPACING if index > 0 else '') + CHARACTERS[character][y]
+    return rows
+
+
+def write_png(path, rows):
+    """Write rows of '#' (black) and '.' (white) as a 1-bit palette PNG."""
+    width = len(rows[0])
+    raw = b''
+    for row in rows:
+        bits = ''.join('0' if pixel == '#' else '1' for pixel in row)
+        bits += '1' * (-len(bits) % 8)
+        raw += b'\0' + bytes(int(bits[i:i + 8], 2) for i in range(0, len(bits), 8))
+
+    def chunk(kind, data):
+        return struct.pack('>I', len(data)) + kind + data + struct.pack('>I', zlib.crc32(kind + data) & 0xffffffff)
+
+    with open(path, 'wb') as output:
+        output.write(b'\x89PNG\r\n\x1a\n')
+        output.write(chunk(b'IHDR', struct.pack('>IIBBBBB', width, len(rows), 1, 3, 0, 0, 0)))
+        output.write(chunk(b'PLTE', b'\x00\x00\x00\xff\xff\xff'))
+        output.write(chunk(b'IDAT', zlib.compress(raw, 9)))
+        output.write(chunk(b'IEND', b''))
+
+
+if __name__ == '__main__':
+    strip = [''] * HEIGHT
+    table = []
+    for glyph in GLYPHS:
+        rows = render(glyph)
+        table.append((len(strip[0]), len(rows[0]), glyph))
+        for y in range(HEIGHT):
+            strip[y] += rows[y] + '.' * SPACING
+
+    write_png(os.path.join(ROOT, 'resources', 'images', 'status_glyphs.png'), strip)
+
+    print('static const StatusGlyphSpan _glyphSpans[GLYPH_COUNT] = {')
+    for left, width, glyph in table:
+        print('  { %d, %d }, // %s' % (left, width, glyph))
+    print('};')
\ No newline at end of file
@@ -0,0 +1,237 @@
+#!/usr/bin/env python
+"""Generate the stroke table used by src/vector_digits.c.
+
+    python tools/vector_digits.py            print the C table
+    python tools/vector_digits.py --check    compare against resources/images
+
+Each digit is described as a few pen strokes (straight runs, superellipse arcs
+and rings) whose parameters were fitted to the 59x84 digit bitmaps. A stroke is
+expanded into its outline by offsetting the centre line by half the pen width
+to either side, and the watch fills each outline with one gpath_draw_filled.
+--check rasterises the outlines the same way and reports the overlap
+(intersection over union) with each bitmap.
+"""
+
+import math
+import os
+import struct
+import sys
+import zlib
+
+WIDTH = 59
+HEIGHT = 84
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+
+
+def arc(cx, cy, rx, ry, start, end, exponent=2.0, step=10):
+    """Points along a superellipse arc, angles in degrees."""
+    count = max(1, int(round(abs(end - start) / step)))
+    points = []
+    for i in range(count + 1):
+        angle = math.radians(start + (end - start) * i / count)
+        c = math.cos(angle)
+        s = math.sin(angle)
+        points.append((cx + rx * math.copysign(abs(c) ** (2 / exponent), c),
+                       cy + ry * math.copysign(abs(s) ** (2 / exponent), s)))
+    return points
+
+
+def ring(cx, cy, rx, ry, exponent):
+    return arc(cx, cy, rx, ry, 0, 360, exponent)[:-1]
+
+
+def line(*points):
+    return list(points)
+
+
+# Strokes per digit as (pen width, centre line points, closed).
+DIGITS = {
+    0: [(10.5, ring(29, 42, 20.5, 37.5, 3.0), True)],
+    1: [(11, line((36.5, -5), (36.5, 90)), False),
+        (10, line((13, 6.5), (36.5, 6.5)), False)],
+    2: [(10, arc(28, 23, 19.5, 19, 177.5, 383, 2.15) + [(10, 77)], False),
+        (10, line((3, 80), (55, 80)), False)],
+    3: [(10, arc(29.5, 22.5, 20, 18.5, 178, 445, 2.03) + [(20, 40.5)], False),
+        (10, [(20, 40.5)] + arc(29.5, 60, 20.5, 20.5, 291, 540, 2.0), False)],
+    4: [(11, line((41.5, -5), (41.5, 90)), False),
+        (8, line((38, 3), (6, 61)), False),
+        (9, line((0, 60.5), (59, 60.5)), False)],
+    5: [(10.5, line((15, 4.5), (51, 4.5)), False),
+        (10.5, line((15, 4.5), (10, 43.5)), False),
+        (10.5, [(10, 45.5)] + arc(28.5, 56.5, 20, 22.5, 255.5, 520, 2.35), False)],
+    6: [(10, ring(29.5, 57, 20.5, 23, 2.0), True),
+        (10, arc(33, 40.5, 25.5, 36.5, 299, 164, 2.3), False)],
+    7: [(10, line((2, 4), (57, 4)), False),
+        (11, line((48.5, 8), (24, 58), (25, 90)), False)],
+    8: [(10, ring(29.5, 22.5, 18.5, 19, 2.0), True),
+        (10, ring(29.5, 60.5, 21, 20, 2.0), True)],
+    9: [(10, ring(29, 27.5, 20.5, 23.5, 2.13), True),
+        (10, line((50, 22), (50, 57)) + arc(25, 57, 25, 23.5, 0, 127.5, 1.9)[1:], False)],
+}
+
+
+def normalize(vector):
+    length = math.hypot(vector[0], vector[1])
+    return (vector[0] / length, vector[1] / length) if length else (0, 0)
+
+
+def offset(points, width, closed):
+    """Edges across the pen at each centre line point, mitred at the joins."""
+    count = len(points)
+    edges = []
+    for i in range(count):
+        point = points[i]
+        normals = []
+        if i > 0 or closed:
+            direction = normalize((point[0] - points[i - 1][0], point[1] - points[i - 1][1]))
+            normals.append((-direction[1], direction[0]))
+        if i < count - 1 or closed:
+            following = points[(i + 1) % count]
+            direction = normalize((following[0] - point[0], following[1] - point[1]))
+            normals.append((-direction[1], direction[0]))
+
+        mitre = normalize((sum(n[0] for n in normals), sum(n[1] for n in normals)))
+        half = width / 2 / max(0.5, mitre[0] * normals[0][0] + mitre[1] * normals[0][1])
+        edges.append((point[0] + mitre[0] * half, point[1] + mitre[1] * half,
+                      point[0] - mitre[0] * half, point[1] - mitre[1] * half))
+
+    if closed:
+        edges.append(edges[0])
+    return edges
+
+
+def clamp(value, limit):
+    return min(max(int(round(value)), 0), limit)
+
+
+def outlines(digit):
+    """One polygon per stroke: down one side of the pen and back up the other.
+    Rings are split into two halves so that no polygon has a hole."""
+    result = []
+    for width, points, closed in DIGITS[digit]:
+        edges = [(clamp(e[0], WIDTH), clamp(e[1], HEIGHT), clamp(e[2], WIDTH), clamp(e[3], HEIGHT))
+                 for e in offset(points, width, closed)]
+        halves = [edges[:len(edges) // 2 + 1], edges[len(edges) // 2:]] if closed else [edges]
+        for half in halves:
+            result.append([(e[0], e[1]) for e in half] + [(e[2], e[3]) for e in reversed(half)])
+    return result
+
+
+def print_table():
+    points = []
+    path_ranges = []
+    first_path = []
+    for digit in range(10):
+        first_path.append(len(path_ranges))
+        for outline in outlines(digit):
+            path_ranges.append((len(points), len(outline), digit))
+            points.extend(outline)
+    first_path.append(len(path_ranges))
+
+    print('static const DigitPoint _digitPoints[%d] = {' % len(points))
+    for index, (first, count, digit) in enumerate(path_ranges):
+        run = points[first:first + count]
+        if index == first_path[digit]:
+            print('  // %d' % digit)
+        for i in range(0, len(run), 8):
+            print('  ' + ' '.join('{ %d, %d },' % point for point in run[i:i + 8]))
+    print('};')
+    print('')
+    print('static const DigitPath _digitPaths[%d] = {' % len(path_ranges))
+    for first, count, digit in path_ranges:
+        print('  { %d, %d },' % (first, count))
+    print('};')
+    print('')
+    print('#define DIGIT_PATH_MAX_POINTS %d' % max(count for _, count, _ in path_ranges))
+    print('static const uint8_t _digitFirstPath[11] = { %s };' % ', '.join(str(p) for p in first_path))
+
+
+def load_png(path):
+    """Decode a palette PNG into rows of booleans, True where the pixel is dark."""
+    data = open(path, 'rb').read()
+    position = 8
+    compressed = b''
+    while position < len(data):
+        length, = struct.unpack('>I', data[position:position + 4])
+        kind = data[position + 4:position + 8]
+        chunk = data[position + 8:position + 8 + length]
+        position += 12 + length
+        if kind == b'IHDR':
+            width, height, depth = struct.unpack('>IIB', chunk[:9])
+        elif kind == b'PLTE':
+            palette = chunk
+        elif kind == b'IDAT':
+            compressed += chunk
+
+    raw = zlib.decompress(compressed)
+    stride = (width * depth + 7) // 8
+    rows = []
+    previous = bytearray(stride)
+    index = 0
+    for y in range(height):
+        kind = raw[index]
+        row = bytearray(raw[index + 1:index + 1 + stride])
+        index += 1 + stride
+        for x in range(stride):
+            a = row[x - 1] if x >= 1 else 0
+            b = previous[x]
+            c = previous[x - 1] if x >= 1 else 0
+            if kind == 1:
+                row[x] = (row[x] + a) & 255
+            elif kind == 2:
+                row[x] = (row[x] + b) & 255
+            elif kind == 3:
+                row[x] = (row[x] + (a + b) // 2) & 255
+            elif kind == 4:
+                p = a + b - c
+                predictor = min((abs(p - a), 0, a), (abs(p - b), 1, b), (abs(p - c), 2, c))[2]
+                row[x] = (row[x] + predictor) & 255
+        rows.append(row)
+        previous = row
+
+    def dark(x, y):
+        value = (rows[y][x * depth // 8] >> (8 - depth - (x * depth % 8))) & ((1 << depth) - 1)
+        return palette[value * 3] < 128
+
+    return [[dark(x, y) for x in range(width)] for y in range(height)]
+
+
+def inside(polygon, x, y):
+    result = False
+    for i in range(len(polygon)):
+        x1, y1 = polygon[i]
+        x2, y2 = polygon[(i + 1) % len(polygon)]
+        if (y1 > y) != (y2 > y) and x < (x2 - x1) * (y - y1) / float(y2 - y1) + x1:
+            result = not result
+    return result
+
+
+def rasterise(digit):
+    """Fill each outline even-odd, as gpath_draw_filled does, into one bitmap."""
+    pixels = [[False] * WIDTH for _ in range(HEIGHT)]
+    for outline in outlines(digit):
+        left = max(0, min(x for x, _ in outline))
+        right = min(WIDTH - 1, max(x for x, _ in outline))
+        top = max(0, min(y for _, y in outline))
+        bottom = min(HEIGHT - 1, max(y for _, y in outline))
+        for y in range(top, bottom + 1):
+            for x in range(left, right + 1):
+                if not pixels[y][x] and inside(outline, x + 0.5, y + 0.5):
+                    pixels[y][x] = True
+    return pixels
+
+
+def check():
+    for digit in range(10):
+        bitmap = load_png(os.path.join(ROOT, 'resources', 'images', '%d.png' % digit))
+        drawn = rasterise(digit)
+        both = sum(bitmap[y][x] and drawn[y][x] for y in range(HEIGHT) for x in range(WIDTH))
+        either = sum(bitmap[y][x] or drawn[y][x] for y in range(HEIGHT) for x in range(WIDTH))
+        print('%d  %.3f  %d paths' % (digit, both / float(either), len(outlines(digit))))
+
+
+if __name__ == '__main__':
+    if '--check' in sys.argv[1:]:
+        check()
+    else:
+        print_table()
\ No newline at end of file